@@ -0,0 +1,908 @@
+
+#ifndef __HH_MPP_DYNMATRIX
+#define __HH_MPP_DYNMATRIX
+
+#include "mathpp/mathpp.hh"
+#include "mathpp/matrix.hh"
+#include "mathpp/storage.hh"
+#include "mathpp/simd.hh"
+#include "mathpp/gemm.hh"
+#include "mathpp/parallel.hh"
+
+#include <array>
+#include <span>
+#include <vector>
+#include <memory_resource>
+#include <initializer_list>
+#include <algorithm>
+#include <stdexcept>
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * A matrix whose shape is chosen at runtime, stored row-major in a single
+     * contiguous block from `Alloc`. Elements are aligned for vector loads by
+     * default, and may be drawn from a memory pool through a polymorphic
+     * allocator. Operations between matrices of mismatched shapes throw
+     * `std::invalid_argument`.
+     */
+    template <typename Tp, typename Alloc = AlignedAllocator<Tp>>
+    class DynMatrix
+    {
+    public:
+        using allocator_type = Alloc;
+
+        explicit DynMatrix(Alloc const& = Alloc{});
+        explicit DynMatrix(size_t, size_t, Alloc const& = Alloc{});
+        explicit DynMatrix(size_t, size_t, Tp const&, Alloc const& = Alloc{});
+        explicit DynMatrix(size_t, size_t, std::initializer_list<Tp>, Alloc const& = Alloc{});
+
+        template <typename Tq, size_t Nr, size_t Nc>
+            requires (std::is_convertible<Tq,Tp>::value)
+        DynMatrix(Matrix<Tq,Nr,Nc> const&, Alloc const& = Alloc{});
+
+        template <typename Tq, typename Aq>
+            requires (std::is_convertible<Tq,Tp>::value)
+                && (!std::is_same<DynMatrix<Tq,Aq>,DynMatrix<Tp,Alloc>>::value)
+        explicit DynMatrix(DynMatrix<Tq,Aq> const&, Alloc const& = Alloc{});
+
+        template <size_t Nr, size_t Nc>
+        explicit operator Matrix<Tp,Nr,Nc>() const;
+
+        void swap(DynMatrix<Tp,Alloc>&);
+
+    public:
+        auto index(std::array<size_t,2> const& indices) const { return indices[0]*m_Cols + indices[1]; }
+        auto rows() const { return m_Rows; }
+        auto cols() const { return m_Cols; }
+        auto size() const { return m_Rows*m_Cols; }
+        auto shape() const -> std::array<size_t,2> { return {m_Rows,m_Cols}; }
+        auto elements() const -> std::span<Tp const> { return m_Elements; }
+        auto data() const -> Tp const* { return m_Elements.data(); }
+        auto data() -> Tp* { return m_Elements.data(); }
+        auto get_allocator() const -> Alloc { return m_Elements.get_allocator(); }
+
+        void assign(Tp const&);
+
+        auto operator[](size_t index) const -> Tp const& { return m_Elements[index]; }
+        auto operator[](size_t index) -> Tp& { return m_Elements[index]; }
+        auto at(size_t index) const -> Tp const&;
+        auto at(size_t index) -> Tp&;
+
+        auto operator[](std::array<size_t,2> const& indices) const -> Tp const& { return m_Elements[index(indices)]; }
+        auto operator[](std::array<size_t,2> const& indices) -> Tp& { return m_Elements[index(indices)]; }
+        auto at(std::array<size_t,2> const&) const -> Tp const&;
+        auto at(std::array<size_t,2> const&) -> Tp&;
+
+        template <typename Tq, typename Aq>
+        DynMatrix<Tp,Alloc>& operator+=(DynMatrix<Tq,Aq> const&);
+        template <typename Tq, typename Aq>
+        DynMatrix<Tp,Alloc>& operator-=(DynMatrix<Tq,Aq> const&);
+        template <typename Tq>
+        DynMatrix<Tp,Alloc>& operator*=(Tq const&);
+        template <typename Tq>
+        DynMatrix<Tp,Alloc>& operator/=(Tq const&);
+        template <typename Tq>
+        DynMatrix<Tp,Alloc>& operator%=(Tq const&);
+
+    private:
+        template <typename Tq, typename Aq>
+        void conform(DynMatrix<Tq,Aq> const&, char const*) const;
+
+    private:
+        size_t m_Rows = 0;
+        size_t m_Cols = 0;
+        std::vector<Tp,Alloc> m_Elements;
+    };
+
+    namespace pmr
+    {
+
+        // a dynamic matrix drawing its elements from a memory resource
+        template <typename Tp>
+        using DynMatrix = mpp::DynMatrix<Tp,std::pmr::polymorphic_allocator<Tp>>;
+
+    } // namespace pmr
+
+    namespace matrices
+    {
+
+        template <typename Tp, typename Alloc>
+        auto submatrix(DynMatrix<Tp,Alloc> const&, size_t, size_t) -> DynMatrix<Tp,Alloc>;
+
+        template <typename Tp, typename Alloc>
+        auto determinant(DynMatrix<Tp,Alloc> const&) -> Tp;
+
+        template <typename Tp, typename Alloc>
+        auto trace(DynMatrix<Tp,Alloc> const&) -> Tp;
+
+        template <execution_policy Policy, typename Tp, typename Ap, typename Aq>
+        auto multiply(Policy const&, DynMatrix<Tp,Ap> const&, DynMatrix<Tp,Aq> const&) -> DynMatrix<Tp,Ap>;
+
+        template <execution_policy Policy, typename Tp, typename Alloc>
+        auto determinant(Policy const&, DynMatrix<Tp,Alloc> const&) -> Tp;
+
+        template <execution_policy Policy, typename Tp, typename Alloc>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        auto invert(Policy const&, DynMatrix<Tp,Alloc> const&) -> DynMatrix<Tp,Alloc>;
+
+        /*
+         * The factorisation PA = LU of a square matrix whose order is chosen
+         * at runtime, with the same solves as the fixed-size factorisation.
+         */
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        class LU<Tp,std::dynamic_extent>
+        {
+        public:
+            template <typename Alloc>
+            explicit LU(DynMatrix<Tp,Alloc> const&);
+
+            template <execution_policy Policy, typename Alloc>
+            LU(Policy const&, DynMatrix<Tp,Alloc> const&);
+
+        public:
+            bool singular() const { return m_Singular; }
+            auto order() const { return m_Factors.rows(); }
+            auto factors() const -> DynMatrix<Tp> const& { return m_Factors; }
+            auto pivots() const -> std::span<size_t const> { return m_Pivots; }
+
+            auto determinant() const -> Tp;
+            auto inverse() const -> DynMatrix<Tp>;
+
+            // solves A X = B
+            template <typename Alloc>
+            auto solve(DynMatrix<Tp,Alloc>) const -> DynMatrix<Tp,Alloc>;
+
+            template <execution_policy Policy, typename Alloc>
+            auto solve(Policy const&, DynMatrix<Tp,Alloc>) const -> DynMatrix<Tp,Alloc>;
+
+            // solves A x = b in place
+            void solve(std::span<Tp>) const;
+
+            // solves X A = B
+            template <typename Alloc>
+            auto rsolve(DynMatrix<Tp,Alloc>) const -> DynMatrix<Tp,Alloc>;
+
+        private:
+            void validate(size_t, char const*) const;
+
+        private:
+            DynMatrix<Tp> m_Factors;
+            std::vector<Tp> m_Reciprocals;
+            std::vector<size_t> m_Pivots;
+            bool m_Odd = false;
+            bool m_Singular = false;
+        };
+
+    } // namespace matrices
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// MathPP Specialisations
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    // identity
+
+    template <typename Tp, typename Alloc>
+    struct identity<DynMatrix<Tp,Alloc>,op_add>
+    {
+        constexpr static tristate has()
+        {
+            return identity<Tp,op_add>::has();
+        }
+        static DynMatrix<Tp,Alloc> get(size_t rows, size_t cols)
+        {
+            return DynMatrix<Tp,Alloc>{rows,cols,identity<Tp,op_add>::get()};
+        }
+        static DynMatrix<Tp,Alloc>& make(DynMatrix<Tp,Alloc>& mat)
+        {
+            mat.assign(identity<Tp,op_add>::get());
+            return mat;
+        }
+    };
+
+    template <typename Tp, typename Alloc>
+    struct identity<DynMatrix<Tp,Alloc>,op_mul>
+    {
+        constexpr static tristate has()
+        {
+            // only square matrices have a multiplicative identity
+            return (identity<Tp,op_mul>::has() != logic::none) ? logic::some : logic::none;
+        }
+        static DynMatrix<Tp,Alloc> get(size_t order)
+        {
+            auto result = DynMatrix<Tp,Alloc>{order,order,identity<Tp,op_add>::get()};
+            for (size_t i = 0; i < order; ++i)
+            {
+                result[{i,i}] = identity<Tp,op_mul>::get();
+            }
+            return result;
+        }
+        static DynMatrix<Tp,Alloc>& make(DynMatrix<Tp,Alloc>& mat)
+        {
+            if (mat.rows() != mat.cols()) throw std::invalid_argument("mpp::identity<DynMatrix>::make");
+            return mat = get(mat.rows());
+        }
+    };
+
+    // inverse
+
+    template <typename Tp, typename Alloc>
+        requires (inverse<Tp,op_add>::has() != logic::none)
+    struct inverse<DynMatrix<Tp,Alloc>,op_add>
+    {
+        constexpr static tristate has()
+        {
+            return inverse<Tp,op_add>::has();
+        }
+        static bool can(DynMatrix<Tp,Alloc> const&)
+        {
+            return true;
+        }
+        static DynMatrix<Tp,Alloc> get(DynMatrix<Tp,Alloc> const& matrix)
+        {
+            return -matrix;
+        }
+        static DynMatrix<Tp,Alloc>& make(DynMatrix<Tp,Alloc>& matrix)
+        {
+            return matrix = get(matrix);
+        }
+    };
+
+    template <typename Tp, typename Alloc>
+        requires (inverse<Tp,op_mul>::has() == logic::all)
+    struct inverse<DynMatrix<Tp,Alloc>,op_mul>
+    {
+        constexpr static tristate has()
+        {
+            return logic::some;
+        }
+        static bool can(DynMatrix<Tp,Alloc> const& matrix)
+        {
+            if (matrix.rows() != matrix.cols()) return false;
+            return !matrices::LU<Tp>{matrix}.singular();
+        }
+        static DynMatrix<Tp,Alloc> get(DynMatrix<Tp,Alloc> const& matrix)
+        {
+            auto const ident = identity<DynMatrix<Tp,Alloc>,op_mul>::get(matrix.rows());
+            return matrices::LU<Tp>{matrix}.solve(ident);
+        }
+        static DynMatrix<Tp,Alloc>& make(DynMatrix<Tp,Alloc>& matrix)
+        {
+            return matrix = get(matrix);
+        }
+    };
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Namespace Functions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace matrices
+    {
+
+        template <typename Tp, typename Alloc>
+        auto submatrix(DynMatrix<Tp,Alloc> const& matrix, size_t i, size_t j) -> DynMatrix<Tp,Alloc>
+        {
+            if (matrix.rows() == 0 || matrix.cols() == 0)
+            {
+                throw std::invalid_argument("mpp::matrices::submatrix");
+            }
+            DynMatrix<Tp,Alloc> result{matrix.rows()-1,matrix.cols()-1,matrix.get_allocator()};
+
+            size_t index = 0;
+            for (size_t m = 0; m < matrix.rows(); ++m) {
+                if (m == i) continue;
+                for (size_t n = 0; n < matrix.cols(); ++n) {
+                    if (n == j) continue;
+                    result[index++] = matrix[{m,n}];
+                }
+            }
+            return result;
+        }
+
+        template <typename Tp, typename Alloc>
+        auto determinant(DynMatrix<Tp,Alloc> const& matrix) -> Tp
+        {
+            if (matrix.rows() != matrix.cols()) throw std::invalid_argument("mpp::matrices::determinant");
+
+            if constexpr (inverse<Tp,op_mul>::has() == logic::all) {
+                return LU<Tp>{matrix}.determinant();
+            } else if constexpr (exact_division<Tp>::value) {
+                auto copy = std::vector<Tp>(matrix.elements().begin(),matrix.elements().end());
+                return bareiss(copy.data(),matrix.rows());
+            } else {
+                static_assert(inverse<Tp,op_add>::has() != logic::none,
+                    "mpp::matrices::determinant needs exact division or additive inverses");
+                if (matrix.rows() == 1) return matrix[0];
+
+                Tp result = identity<Tp,op_add>::get();
+
+                auto multiplier = identity<Tp,op_mul>::get();
+                for (size_t i = 0; i < matrix.rows(); ++i)
+                {
+                    auto const det = determinant(submatrix(matrix,i,0));
+                    result += multiplier * det * matrix[{i,0}];
+                    inverse<Tp,op_add>::make(multiplier);
+                }
+                return result;
+            }
+        }
+
+        template <typename Tp, typename Alloc>
+        auto trace(DynMatrix<Tp,Alloc> const& matrix) -> Tp
+        {
+            if (matrix.rows() != matrix.cols()) throw std::invalid_argument("mpp::matrices::trace");
+
+            Tp result = identity<Tp,op_add>::get();
+
+            for (size_t i = 0; i < matrix.rows(); ++i)
+            {
+                result += matrix[{i,i}];
+            }
+            return result;
+        }
+
+        template <execution_policy Policy, typename Tp, typename Ap, typename Aq>
+        auto multiply(Policy const& policy, DynMatrix<Tp,Ap> const& matrix1, DynMatrix<Tp,Aq> const& matrix2) -> DynMatrix<Tp,Ap>
+        {
+            if (matrix1.cols() != matrix2.rows()) throw std::invalid_argument("mpp::matrices::multiply");
+
+            size_t const nr = matrix1.rows(), nc = matrix1.cols(), nz = matrix2.cols();
+            DynMatrix<Tp,Ap> result{nr,nz,identity<Tp,op_add>::get(),matrix1.get_allocator()};
+
+            if constexpr (std::is_arithmetic<Tp>::value && !std::is_same<Tp,bool>::value)
+            {
+                if (nr*nc*nz >= gemm::threshold)
+                {
+                    gemm::multiply<Tp>(policy,nr,nz,nc,
+                        {matrix1.data(),nc,1}, {matrix2.data(),nz,1}, {result.data(),nz,1});
+                    return result;
+                }
+            }
+
+            // rows of the result are independent, and each is summed in order
+            policy.for_each(0,nr,execution::grain_for(nc*nz),[&](size_t lo, size_t hi)
+            {
+                for (size_t i = lo; i < hi; ++i)
+                {
+                    for (size_t k = 0; k < nc; ++k)
+                    {
+                        auto const& element = matrix1[{i,k}];
+                        for (size_t j = 0; j < nz; ++j)
+                        {
+                            result[{i,j}] += element * matrix2[{k,j}];
+                        }
+                    }
+                }
+            });
+            return result;
+        }
+
+        template <execution_policy Policy, typename Tp, typename Alloc>
+        auto determinant(Policy const& policy, DynMatrix<Tp,Alloc> const& matrix) -> Tp
+        {
+            if (matrix.rows() != matrix.cols()) throw std::invalid_argument("mpp::matrices::determinant");
+
+            if constexpr (inverse<Tp,op_mul>::has() == logic::all) {
+                return LU<Tp>{policy,matrix}.determinant();
+            } else if constexpr (exact_division<Tp>::value) {
+                auto copy = std::vector<Tp>(matrix.elements().begin(),matrix.elements().end());
+                return bareiss(policy,copy.data(),matrix.rows());
+            } else {
+                return determinant(matrix);
+            }
+        }
+
+        template <execution_policy Policy, typename Tp, typename Alloc>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        auto invert(Policy const& policy, DynMatrix<Tp,Alloc> const& matrix) -> DynMatrix<Tp,Alloc>
+        {
+            auto const ident = identity<DynMatrix<Tp,Alloc>,op_mul>::get(matrix.rows());
+            return LU<Tp>{policy,matrix}.solve(policy,ident);
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <typename Alloc>
+        LU<Tp,std::dynamic_extent>::LU(DynMatrix<Tp,Alloc> const& matrix)
+            : LU{execution::seq,matrix}
+        {
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <execution_policy Policy, typename Alloc>
+        LU<Tp,std::dynamic_extent>::LU(Policy const& policy, DynMatrix<Tp,Alloc> const& matrix)
+            : m_Factors{matrix}
+            , m_Reciprocals(matrix.rows())
+            , m_Pivots(matrix.rows())
+        {
+            if (matrix.rows() != matrix.cols()) throw std::invalid_argument("mpp::matrices::LU");
+
+            auto const regular = lu_factor(policy,m_Factors.data(),order(),m_Pivots.data(),m_Reciprocals.data(),m_Odd);
+            m_Singular = !regular;
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        auto LU<Tp,std::dynamic_extent>::determinant() const -> Tp
+        {
+            if (m_Singular) return identity<Tp,op_add>::get();
+
+            Tp result = identity<Tp,op_mul>::get();
+            for (size_t k = 0; k < order(); ++k)
+            {
+                result *= m_Factors[{k,k}];
+            }
+            return m_Odd ? mpp::inverse<Tp,op_add>::get(result) : result;
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        auto LU<Tp,std::dynamic_extent>::inverse() const -> DynMatrix<Tp>
+        {
+            return solve(identity<DynMatrix<Tp>,op_mul>::get(order()));
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <typename Alloc>
+        auto LU<Tp,std::dynamic_extent>::solve(DynMatrix<Tp,Alloc> b) const -> DynMatrix<Tp,Alloc>
+        {
+            return solve(execution::seq,std::move(b));
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <execution_policy Policy, typename Alloc>
+        auto LU<Tp,std::dynamic_extent>::solve(Policy const& policy, DynMatrix<Tp,Alloc> b) const -> DynMatrix<Tp,Alloc>
+        {
+            validate(b.rows(),"mpp::matrices::LU::solve");
+            lu_solve(policy,m_Factors.data(),order(),m_Pivots.data(),m_Reciprocals.data(),b.data(),b.cols());
+            return b;
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        void LU<Tp,std::dynamic_extent>::solve(std::span<Tp> b) const
+        {
+            validate(b.size(),"mpp::matrices::LU::solve");
+            lu_solve(m_Factors.data(),order(),m_Pivots.data(),m_Reciprocals.data(),b.data(),1);
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <typename Alloc>
+        auto LU<Tp,std::dynamic_extent>::rsolve(DynMatrix<Tp,Alloc> b) const -> DynMatrix<Tp,Alloc>
+        {
+            validate(b.cols(),"mpp::matrices::LU::rsolve");
+            lu_rsolve(m_Factors.data(),order(),m_Pivots.data(),m_Reciprocals.data(),b.data(),b.rows());
+            return b;
+        }
+
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        void LU<Tp,std::dynamic_extent>::validate(size_t extent, char const* what) const
+        {
+            if (extent != order()) throw std::invalid_argument(what);
+            if (m_Singular) throw std::domain_error(what);
+        }
+
+    } // namespace matrices
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, typename Alloc>
+    DynMatrix<Tp,Alloc>::DynMatrix(Alloc const& alloc)
+        : m_Elements(alloc)
+    {
+    }
+
+    template <typename Tp, typename Alloc>
+    DynMatrix<Tp,Alloc>::DynMatrix(size_t rows, size_t cols, Alloc const& alloc)
+        : DynMatrix(rows,cols,identity<Tp,op_add>::get(),alloc)
+    {
+    }
+
+    template <typename Tp, typename Alloc>
+    DynMatrix<Tp,Alloc>::DynMatrix(size_t rows, size_t cols, Tp const& value, Alloc const& alloc)
+        : m_Rows{rows}
+        , m_Cols{cols}
+        , m_Elements(rows*cols,value,alloc)
+    {
+    }
+
+    template <typename Tp, typename Alloc>
+    DynMatrix<Tp,Alloc>::DynMatrix(size_t rows, size_t cols, std::initializer_list<Tp> list, Alloc const& alloc)
+        : m_Rows{rows}
+        , m_Cols{cols}
+        , m_Elements(list,alloc)
+    {
+        if (list.size() != rows*cols) throw std::invalid_argument("mpp::DynMatrix::DynMatrix");
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq, size_t Nr, size_t Nc>
+        requires (std::is_convertible<Tq,Tp>::value)
+    DynMatrix<Tp,Alloc>::DynMatrix(Matrix<Tq,Nr,Nc> const& matrix, Alloc const& alloc)
+        : m_Rows{Nr}
+        , m_Cols{Nc}
+        , m_Elements(matrix.elements().begin(),matrix.elements().end(),alloc)
+    {
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq, typename Aq>
+        requires (std::is_convertible<Tq,Tp>::value)
+            && (!std::is_same<DynMatrix<Tq,Aq>,DynMatrix<Tp,Alloc>>::value)
+    DynMatrix<Tp,Alloc>::DynMatrix(DynMatrix<Tq,Aq> const& other, Alloc const& alloc)
+        : m_Rows{other.rows()}
+        , m_Cols{other.cols()}
+        , m_Elements(other.elements().begin(),other.elements().end(),alloc)
+    {
+    }
+
+    template <typename Tp, typename Alloc>
+    template <size_t Nr, size_t Nc>
+    DynMatrix<Tp,Alloc>::operator Matrix<Tp,Nr,Nc>() const
+    {
+        if (m_Rows != Nr || m_Cols != Nc) throw std::invalid_argument("mpp::DynMatrix::operator Matrix");
+
+        Matrix<Tp,Nr,Nc> result;
+        std::copy(m_Elements.begin(),m_Elements.end(),result.data());
+        return result;
+    }
+
+    template <typename Tp, typename Alloc>
+    void DynMatrix<Tp,Alloc>::swap(DynMatrix<Tp,Alloc>& other)
+    {
+        std::swap(m_Rows,other.m_Rows);
+        std::swap(m_Cols,other.m_Cols);
+        m_Elements.swap(other.m_Elements);
+    }
+
+    template <typename Tp, typename Alloc>
+    void DynMatrix<Tp,Alloc>::assign(Tp const& value)
+    {
+        std::fill(m_Elements.begin(),m_Elements.end(),value);
+    }
+
+    template <typename Tp, typename Alloc>
+    auto DynMatrix<Tp,Alloc>::at(size_t index) const -> Tp const&
+    {
+        if (index >= size()) throw std::out_of_range("mpp::DynMatrix::at");
+        return m_Elements[index];
+    }
+
+    template <typename Tp, typename Alloc>
+    auto DynMatrix<Tp,Alloc>::at(size_t index) -> Tp&
+    {
+        if (index >= size()) throw std::out_of_range("mpp::DynMatrix::at");
+        return m_Elements[index];
+    }
+
+    template <typename Tp, typename Alloc>
+    auto DynMatrix<Tp,Alloc>::at(std::array<size_t,2> const& indices) const -> Tp const&
+    {
+        if (indices[0] >= m_Rows || indices[1] >= m_Cols) throw std::out_of_range("mpp::DynMatrix::at");
+        return m_Elements[index(indices)];
+    }
+
+    template <typename Tp, typename Alloc>
+    auto DynMatrix<Tp,Alloc>::at(std::array<size_t,2> const& indices) -> Tp&
+    {
+        if (indices[0] >= m_Rows || indices[1] >= m_Cols) throw std::out_of_range("mpp::DynMatrix::at");
+        return m_Elements[index(indices)];
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq, typename Aq>
+    void DynMatrix<Tp,Alloc>::conform(DynMatrix<Tq,Aq> const& other, char const* what) const
+    {
+        if (m_Rows != other.rows() || m_Cols != other.cols()) throw std::invalid_argument(what);
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq, typename Aq>
+    DynMatrix<Tp,Alloc>& DynMatrix<Tp,Alloc>::operator+=(DynMatrix<Tq,Aq> const& other)
+    {
+        conform(other,"mpp::DynMatrix::operator+=");
+
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp>)
+        {
+            if (size() >= simd::threshold)
+            {
+                simd::add(data(),other.data(),size());
+                return *this;
+            }
+        }
+        for (size_t i = 0; i < size(); ++i)
+        {
+            m_Elements[i] += other[i];
+        }
+        return *this;
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq, typename Aq>
+    DynMatrix<Tp,Alloc>& DynMatrix<Tp,Alloc>::operator-=(DynMatrix<Tq,Aq> const& other)
+    {
+        conform(other,"mpp::DynMatrix::operator-=");
+
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp>)
+        {
+            if (size() >= simd::threshold)
+            {
+                simd::sub(data(),other.data(),size());
+                return *this;
+            }
+        }
+        for (size_t i = 0; i < size(); ++i)
+        {
+            m_Elements[i] -= other[i];
+        }
+        return *this;
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq>
+    DynMatrix<Tp,Alloc>& DynMatrix<Tp,Alloc>::operator*=(Tq const& scalar)
+    {
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp>)
+        {
+            if (size() >= simd::threshold)
+            {
+                simd::mul(data(),scalar,size());
+                return *this;
+            }
+        }
+        for (auto& element : m_Elements)
+        {
+            element *= scalar;
+        }
+        return *this;
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq>
+    DynMatrix<Tp,Alloc>& DynMatrix<Tp,Alloc>::operator/=(Tq const& scalar)
+    {
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp>)
+        {
+            if (size() >= simd::threshold)
+            {
+                simd::div(data(),scalar,size());
+                return *this;
+            }
+        }
+        for (auto& element : m_Elements)
+        {
+            element /= scalar;
+        }
+        return *this;
+    }
+
+    template <typename Tp, typename Alloc>
+    template <typename Tq>
+    DynMatrix<Tp,Alloc>& DynMatrix<Tp,Alloc>::operator%=(Tq const& scalar)
+    {
+        for (auto& element : m_Elements)
+        {
+            modulo<Tp,Tq>::make(element,scalar);
+        }
+        return *this;
+    }
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Non-Member Extensions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, typename Tq, typename Ap, typename Aq>
+        requires requires (Tp a, Tq b) { a != b; }
+    bool operator==(DynMatrix<Tp,Ap> const& matrix1, DynMatrix<Tq,Aq> const& matrix2)
+    {
+        if (matrix1.shape() != matrix2.shape()) return false;
+
+        for (size_t i = 0; i < matrix1.size(); ++i)
+        {
+            if (matrix1[i] != matrix2[i]) return false;
+        }
+        return true;
+    }
+
+    template <typename Tp, typename Alloc>
+        requires (identity<Tp,op_add>::has() != logic::none)
+    auto operator+(DynMatrix<Tp,Alloc> const& matrix)
+    {
+        return matrix;
+    }
+
+    template <typename Tp, typename Alloc>
+        requires (identity<Tp,op_add>::has() != logic::none)
+    auto operator-(DynMatrix<Tp,Alloc> const& matrix)
+    {
+        auto result = identity<DynMatrix<Tp,Alloc>,op_add>::get(matrix.rows(),matrix.cols());
+        result -= matrix;
+        return result;
+    }
+
+    namespace matrices
+    {
+        // the operand itself when no promotion is needed, else a copy of it
+        // with elements of type `Tr`, drawn from the rebound allocator;
+        // element-wise results take the type of the element operation, so
+        // that `DynMatrix<int>{...} * 2.5` holds doubles
+        template <typename Tr, typename Tp, typename Alloc>
+        auto promote(DynMatrix<Tp,Alloc> matrix)
+        {
+            if constexpr (std::is_same<Tr,Tp>::value)
+            {
+                return matrix;
+            }
+            else
+            {
+                using Ar = typename std::allocator_traits<Alloc>::template rebind_alloc<Tr>;
+                return DynMatrix<Tr,Ar>{matrix,Ar{matrix.get_allocator()}};
+            }
+        }
+    }
+
+    template <typename Tp, typename Tq, typename Ap, typename Aq>
+        requires requires (Tp a, Tq b) { a + b; }
+    auto operator+(DynMatrix<Tp,Ap> matrix1, DynMatrix<Tq,Aq> const& matrix2)
+    {
+        using Tr = decltype(std::declval<Tp>() + std::declval<Tq>());
+        auto result = matrices::promote<Tr>(std::move(matrix1));
+        result += matrix2;
+        return result;
+    }
+
+    template <typename Tp, typename Tq, typename Ap, typename Aq>
+        requires requires (Tp a, Tq b) { a - b; }
+    auto operator-(DynMatrix<Tp,Ap> matrix1, DynMatrix<Tq,Aq> const& matrix2)
+    {
+        using Tr = decltype(std::declval<Tp>() - std::declval<Tq>());
+        auto result = matrices::promote<Tr>(std::move(matrix1));
+        result -= matrix2;
+        return result;
+    }
+
+    template <typename Tp, typename Tq, typename Alloc>
+        requires requires (Tp a, Tq b) { a * b; }
+    auto operator*(DynMatrix<Tp,Alloc> matrix, Tq const& scalar)
+    {
+        using Tr = decltype(std::declval<Tp>() * scalar);
+        auto result = matrices::promote<Tr>(std::move(matrix));
+        result *= scalar;
+        return result;
+    }
+
+    template <typename Tp, typename Tq, typename Alloc>
+        requires requires (Tp a, Tq b) { b * a; }
+    auto operator*(Tq const& scalar, DynMatrix<Tp,Alloc> matrix)
+    {
+        using Tr = decltype(scalar * std::declval<Tp>());
+        auto result = matrices::promote<Tr>(std::move(matrix));
+        result *= scalar;
+        return result;
+    }
+
+    template <typename Tp, typename Tq, typename Alloc>
+        requires requires (Tp a, Tq b) { a / b; }
+    auto operator/(DynMatrix<Tp,Alloc> matrix, Tq const& scalar)
+    {
+        using Tr = decltype(std::declval<Tp>() / scalar);
+        auto result = matrices::promote<Tr>(std::move(matrix));
+        result /= scalar;
+        return result;
+    }
+
+    template <typename Tp, typename Tq, typename Alloc>
+        requires (modulo<Tp,Tq>::has() != logic::none)
+    auto operator%(DynMatrix<Tp,Alloc> matrix, Tq const& scalar)
+    {
+        using Tr = decltype(modulo<Tp,Tq>::get(std::declval<Tp>(),scalar));
+        auto result = matrices::promote<Tr>(std::move(matrix));
+        result %= scalar;
+        return result;
+    }
+
+    template <typename Tp, typename Tq, typename Ap, typename Aq>
+        requires requires (Tp a, Tq b) { a * b; }
+    auto operator*(DynMatrix<Tp,Ap> const& matrix1, DynMatrix<Tq,Aq> const& matrix2)
+    {
+        if (matrix1.cols() != matrix2.rows()) throw std::invalid_argument("mpp::operator*(DynMatrix,DynMatrix)");
+
+        using Tr = op_mul::result<Tp,Tq>::type;
+        using Ar = typename std::allocator_traits<Ap>::template rebind_alloc<Tr>;
+        size_t const nr = matrix1.rows(), nc = matrix1.cols(), nz = matrix2.cols();
+        DynMatrix<Tr,Ar> result{nr,nz,identity<Tr,op_add>::get(),Ar{matrix1.get_allocator()}};
+
+        if constexpr (std::is_same<Tp,Tq>::value && std::is_same<Tr,Tp>::value
+            && std::is_arithmetic<Tp>::value && !std::is_same<Tp,bool>::value)
+        {
+            if (nr*nc*nz >= gemm::threshold)
+            {
+                gemm::multiply<Tp>(nr,nz,nc,
+                    {matrix1.data(),nc,1}, {matrix2.data(),nz,1}, {result.data(),nz,1});
+                return result;
+            }
+        }
+
+        // row-wise, so that the inner loop runs along rows of both operands
+        for (size_t i = 0; i < nr; ++i)
+        {
+            for (size_t k = 0; k < nc; ++k)
+            {
+                auto const& element = matrix1[{i,k}];
+                for (size_t j = 0; j < nz; ++j)
+                {
+                    result[{i,j}] += element * matrix2[{k,j}];
+                }
+            }
+        }
+        return result;
+    }
+
+    template <typename Tp, typename Ap, typename Aq>
+        requires (inverse<DynMatrix<Tp,Aq>,op_mul>::has() != logic::none)
+    auto operator/(DynMatrix<Tp,Ap> const& matrix1, DynMatrix<Tp,Aq> const& matrix2)
+    {
+        // solve against the factors, rather than forming the inverse
+        return matrices::LU<Tp>{matrix2}.rsolve(matrix1);
+    }
+
+    template <typename Tp, typename Tq, typename Alloc>
+        requires (!std::is_same<Tp,DynMatrix<Tq,Alloc>>::value)
+            && (inverse<DynMatrix<Tq,Alloc>,op_mul>::has() != logic::none)
+    auto operator/(Tp const& object, DynMatrix<Tq,Alloc> const& matrix)
+    {
+        using inverse = inverse<DynMatrix<Tq,Alloc>,op_mul>;
+        return object * inverse::get(matrix);
+    }
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Standard Overloads
+/* ************************************************************************** */
+
+namespace std
+{
+
+    template <typename Tp, typename Alloc>
+    void swap(mpp::DynMatrix<Tp,Alloc>& matrix1, mpp::DynMatrix<Tp,Alloc>& matrix2)
+    {
+        return matrix1.swap(matrix2);
+    }
+
+} // namespace std
+
+#endif /* __HH_MPP_DYNMATRIX */
@@ -0,0 +1,335 @@
+
+#ifndef __HH_MPP_EXPR
+#define __HH_MPP_EXPR
+
+#include "mathpp/mathpp.hh"
+
+#include <tuple>
+#include <utility>
+#include <functional>
+#include <type_traits>
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * Element-wise expression traits, specialised by every container that can
+     * take part in lazily evaluated element-wise arithmetic.
+     *  `value_type`    - The element type.
+     *  `result_type`   - The container an expression evaluates into.
+     *  `rebind<Tr>`    - The container of the same shape with elements `Tr`.
+     *  `size`          - The number of elements.
+     */
+    template <typename Tp>
+    struct expression_traits
+    {};
+
+    template <typename Tp>
+    concept expression = requires {
+        typename expression_traits<std::remove_cvref_t<Tp>>::value_type;
+    };
+
+    template <typename Tp>
+    using expression_value_t = typename expression_traits<std::remove_cvref_t<Tp>>::value_type;
+
+    template <typename Tp>
+    using expression_result_t = typename expression_traits<std::remove_cvref_t<Tp>>::result_type;
+
+    template <typename E1, typename E2>
+    concept same_shape = expression<E1> && expression<E2>
+        && std::is_same<
+            typename expression_traits<std::remove_cvref_t<E1>>::template rebind<void>,
+            typename expression_traits<std::remove_cvref_t<E2>>::template rebind<void>
+        >::value;
+
+    /*
+     * A lazily evaluated element-wise expression, evaluating `Fn` over the
+     * elements of its operands into a container `Rt` when assigned. Container
+     * lvalues are held by reference, while container rvalues, expressions,
+     * views and scalars are held by value.
+     */
+    template <typename Rt, typename Fn, typename... Es>
+    class Expression
+    {
+    public:
+        using value_type = typename expression_traits<Rt>::value_type;
+        using result_type = Rt;
+
+        template <typename... Args>
+        constexpr explicit Expression(Fn, Args&&...);
+
+    public:
+        constexpr static auto size() { return expression_traits<Rt>::size; }
+        constexpr auto eval() const -> Rt { return Rt{*this}; }
+        constexpr auto elements() const { return eval().elements(); }
+
+        constexpr auto operator[](size_t) const -> value_type;
+
+    private:
+        template <size_t... Is>
+        constexpr auto element(size_t, std::index_sequence<Is...>) const -> value_type;
+
+    private:
+        Fn m_Function;
+        std::tuple<Es...> m_Operands;
+    };
+
+    template <typename Tp>
+    struct is_expression_node : std::false_type
+    {};
+
+    template <typename Rt, typename Fn, typename... Es>
+    struct is_expression_node<Expression<Rt,Fn,Es...>> : std::true_type
+    {};
+
+    template <typename Tp>
+    concept expression_node = is_expression_node<std::remove_cvref_t<Tp>>::value;
+
+    /*
+     * Views are non-owning windows onto the elements of a container. Like
+     * expression nodes they are cheap to copy, held by value, and evaluate
+     * into their container type.
+     */
+    template <typename Tp>
+    struct is_expression_view : std::false_type
+    {};
+
+    template <typename Tp>
+    concept expression_view = is_expression_view<std::remove_cvref_t<Tp>>::value;
+
+    template <typename Tp>
+    concept expression_proxy = expression_node<Tp> || expression_view<Tp>;
+
+    /*
+     * Whether an expression reads through a view anywhere among its operands.
+     * A view may read elements other than the one being assigned, so a
+     * container assigned such an expression evaluates it into a temporary
+     * first, in case the view refers back to that container.
+     */
+    template <typename Tp>
+    struct holds_expression_view : is_expression_view<Tp>
+    {};
+
+    template <typename Rt, typename Fn, typename... Es>
+    struct holds_expression_view<Expression<Rt,Fn,Es...>>
+        : std::disjunction<holds_expression_view<std::remove_cvref_t<Es>>...>
+    {};
+
+    template <typename Rt, typename Fn, typename... Es>
+    struct expression_traits<Expression<Rt,Fn,Es...>> : expression_traits<Rt>
+    {};
+
+    template <typename E>
+        requires expression<E>
+    constexpr decltype(auto) evaluate(E&&);
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace expressions
+    {
+
+        // how an operand is held within an expression
+        template <typename Tp>
+        using operand_t = std::conditional_t<
+            expression<Tp> && !expression_proxy<Tp> && std::is_lvalue_reference<Tp>::value,
+            std::remove_cvref_t<Tp> const&,
+            std::remove_cvref_t<Tp>
+        >;
+
+        template <typename Tp>
+        constexpr decltype(auto) element(Tp const& operand, size_t i)
+        {
+            if constexpr (expression<Tp>) {
+                return operand[i];
+            } else {
+                return operand;
+            }
+        }
+
+        template <typename Tr, typename Fn, typename E, typename... Args>
+        constexpr auto make(Fn fn, E&& e, Args&&... args)
+        {
+            using Rt = typename expression_traits<std::remove_cvref_t<E>>::template rebind<Tr>;
+            using Ex = Expression<Rt,Fn,operand_t<E&&>,operand_t<Args&&>...>;
+            return Ex{fn,std::forward<E>(e),std::forward<Args>(args)...};
+        }
+
+        template <typename Tr, typename Fn, typename Tq, typename E>
+        constexpr auto make_scalar_first(Fn fn, Tq&& scalar, E&& e)
+        {
+            using Rt = typename expression_traits<std::remove_cvref_t<E>>::template rebind<Tr>;
+            using Ex = Expression<Rt,Fn,operand_t<Tq&&>,operand_t<E&&>>;
+            return Ex{fn,std::forward<Tq>(scalar),std::forward<E>(e)};
+        }
+
+        struct posate
+        {
+            template <typename Tp>
+            constexpr auto operator()(Tp const& e) const { return identity<Tp,op_add>::get() + e; }
+        };
+
+        struct negate
+        {
+            template <typename Tp>
+            constexpr auto operator()(Tp const& e) const { return identity<Tp,op_add>::get() - e; }
+        };
+
+        struct modulus
+        {
+            template <typename Tp, typename Tq>
+            constexpr auto operator()(Tp const& e, Tq const& n) const { return modulo<Tp,Tq>::get(e,n); }
+        };
+
+    } // namespace expressions
+
+    template <typename Rt, typename Fn, typename... Es>
+    template <typename... Args>
+    constexpr Expression<Rt,Fn,Es...>::Expression(Fn fn, Args&&... args)
+        : m_Function{fn}
+        , m_Operands{std::forward<Args>(args)...}
+    {
+    }
+
+    template <typename Rt, typename Fn, typename... Es>
+    constexpr auto Expression<Rt,Fn,Es...>::operator[](size_t i) const -> value_type
+    {
+        return element(i,std::index_sequence_for<Es...>{});
+    }
+
+    template <typename Rt, typename Fn, typename... Es>
+    template <size_t... Is>
+    constexpr auto Expression<Rt,Fn,Es...>::element(size_t i, std::index_sequence<Is...>) const -> value_type
+    {
+        return static_cast<value_type>(m_Function(expressions::element(std::get<Is>(m_Operands),i)...));
+    }
+
+    template <typename E>
+        requires expression<E>
+    constexpr decltype(auto) evaluate(E&& e)
+    {
+        if constexpr (expression_proxy<E>) {
+            return e.eval();
+        } else {
+            return std::forward<E>(e);
+        }
+    }
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Non-Member Extensions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename E1, typename E2>
+        requires (expression_proxy<E1> || expression_proxy<E2>) && same_shape<E1,E2>
+            && requires (expression_value_t<E1> a, expression_value_t<E2> b) { a != b; }
+    constexpr bool operator==(E1 const& e1, E2 const& e2)
+    {
+        for (size_t i = 0; i < e1.size(); ++i)
+        {
+            if (e1[i] != e2[i]) return false;
+        }
+        return true;
+    }
+
+    template <typename E>
+        requires expression<E>
+            && (identity<expression_value_t<E>,op_add>::has() != logic::none)
+    constexpr auto operator+(E&& e)
+    {
+        using Tp = expression_value_t<E>;
+        return expressions::make<Tp>(expressions::posate{},std::forward<E>(e));
+    }
+
+    template <typename E>
+        requires expression<E>
+            && (identity<expression_value_t<E>,op_add>::has() != logic::none)
+    constexpr auto operator-(E&& e)
+    {
+        using Tp = expression_value_t<E>;
+        return expressions::make<Tp>(expressions::negate{},std::forward<E>(e));
+    }
+
+    template <typename E1, typename E2>
+        requires same_shape<E1,E2>
+            && requires (expression_value_t<E1> a, expression_value_t<E2> b) { a + b; }
+    constexpr auto operator+(E1&& e1, E2&& e2)
+    {
+        using Tr = op_add::result<expression_value_t<E1>,expression_value_t<E2>>::type;
+        return expressions::make<Tr>(std::plus<>{},std::forward<E1>(e1),std::forward<E2>(e2));
+    }
+
+    template <typename E1, typename E2>
+        requires same_shape<E1,E2>
+            && requires (expression_value_t<E1> a, expression_value_t<E2> b) { a - b; }
+    constexpr auto operator-(E1&& e1, E2&& e2)
+    {
+        using Tr = op_add::result<expression_value_t<E1>,expression_value_t<E2>>::type;
+        return expressions::make<Tr>(std::minus<>{},std::forward<E1>(e1),std::forward<E2>(e2));
+    }
+
+    template <typename E, typename Tq>
+        requires expression<E> && (!expression<Tq>)
+            && requires (expression_value_t<E> a, Tq b) { a * b; }
+    constexpr auto operator*(E&& e, Tq const& scalar)
+    {
+        using Tr = op_mul::result<expression_value_t<E>,Tq>::type;
+        return expressions::make<Tr>(std::multiplies<>{},std::forward<E>(e),scalar);
+    }
+
+    template <typename E, typename Tq>
+        requires expression<E> && (!expression<Tq>)
+            && requires (expression_value_t<E> a, Tq b) { b * a; }
+    constexpr auto operator*(Tq const& scalar, E&& e)
+    {
+        using Tr = op_mul::result<Tq,expression_value_t<E>>::type;
+        return expressions::make_scalar_first<Tr>(std::multiplies<>{},scalar,std::forward<E>(e));
+    }
+
+    template <typename E, typename Tq>
+        requires expression<E> && (!expression<Tq>)
+            && requires (expression_value_t<E> a, Tq b) { a / b; }
+    constexpr auto operator/(E&& e, Tq const& scalar)
+    {
+        using Tr = op_mul::result<expression_value_t<E>,Tq>::type;
+        return expressions::make<Tr>(std::divides<>{},std::forward<E>(e),scalar);
+    }
+
+    template <typename E, typename Tq>
+        requires expression<E> && (!expression<Tq>)
+            && (modulo<expression_value_t<E>,Tq>::has() != logic::none)
+    constexpr auto operator%(E&& e, Tq const& scalar)
+    {
+        using Tr = op_mul::result<expression_value_t<E>,Tq>::type;
+        return expressions::make<Tr>(expressions::modulus{},std::forward<E>(e),scalar);
+    }
+
+    /*
+     * Products that are not element-wise evaluate their expression operands
+     * first, and then defer to the product of the evaluated containers.
+     */
+    template <typename E1, typename E2>
+        requires (expression_node<E1> || expression_node<E2>)
+            && requires (E1&& e1, E2&& e2) { evaluate(e1) * evaluate(e2); }
+    constexpr auto operator*(E1&& e1, E2&& e2)
+    {
+        return evaluate(std::forward<E1>(e1)) * evaluate(std::forward<E2>(e2));
+    }
+
+} // namespace mpp
+
+#endif /* __HH_MPP_EXPR */
@@ -0,0 +1,421 @@
+
+#ifndef __HH_MPP_FFT
+#define __HH_MPP_FFT
+
+#include <bit>
+#include <span>
+#include <cmath>
+#include <vector>
+#include <limits>
+#include <complex>
+#include <cstdint>
+#include <numbers>
+#include <algorithm>
+#include <type_traits>
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * Quasi-linear convolution of coefficient sequences by discrete Fourier
+     * transforms. Floating sequences use a complex transform, and integral
+     * sequences use number-theoretic transforms over three word-sized primes,
+     * recombined by the Chinese remainder theorem. Integral operands small
+     * enough to round exactly from the complex transform take that instead.
+     * Products report false when they cannot be made exact, or when only
+     * the modular transforms can and the operands are too short to pay for
+     * them, so that the caller may fall back.
+     */
+    namespace fft
+    {
+
+        // a prime modulus p = c 2^k + 1, with a generator of its units
+        template <uint32_t P, uint32_t G>
+        struct prime
+        {
+            constexpr static uint32_t modulus = P;
+            constexpr static uint32_t generator = G;
+            constexpr static size_t max_size = size_t(1) << std::countr_zero(P-1);
+        };
+
+        using prime1 = prime<998244353,3>;                  // 119 2^23 + 1
+        using prime2 = prime<167772161,3>;                  //   5 2^25 + 1
+        using prime3 = prime<469762049,3>;                  //   7 2^26 + 1
+
+        // the shorter operand lengths at which each transform takes over
+        constexpr size_t threshold = 512;
+        constexpr size_t modular_threshold = 8192;
+
+        template <typename Tp>
+            requires std::is_floating_point<Tp>::value
+        void transform(std::span<std::complex<Tp>>, bool inverse);
+
+        template <typename Prime>
+        void transform(std::span<uint32_t>, bool inverse);
+
+        template <typename Prime>
+        void multiply(std::span<uint32_t> result, std::span<uint32_t const> a, std::span<uint32_t const> b);
+
+        template <typename Tp>
+            requires std::is_floating_point<Tp>::value
+        bool multiply(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b);
+
+        template <typename Tp>
+            requires std::is_integral<Tp>::value && (!std::is_same<Tp,bool>::value) && (sizeof(Tp) <= 8)
+        bool multiply(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b);
+
+    } // namespace fft
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace fft
+    {
+
+        inline void bit_reverse(auto* data, size_t n)
+        {
+            for (size_t i = 1, j = 0; i < n; ++i)
+            {
+                size_t bit = n >> 1;
+                for (; j & bit; bit >>= 1) j ^= bit;
+                j ^= bit;
+                if (i < j) std::swap(data[i],data[j]);
+            }
+        }
+
+        // the inverse transform is the forward one, read backwards and scaled
+        inline void reverse_tail(auto* data, size_t n)
+        {
+            std::reverse(data+1,data+n);
+        }
+
+        // twiddles for every stage, those of a stage of length `len` at [len/2,len)
+        template <typename Tp>
+        auto complex_roots(size_t n)
+        {
+            std::vector<std::complex<Tp>> roots(std::max<size_t>(n,2));
+            for (size_t len = 2; len <= n; len <<= 1)
+            {
+                for (size_t j = 0; j < len/2; ++j)
+                {
+                    // every twiddle directly, rather than by accumulated products
+                    auto const angle = 2 * std::numbers::pi_v<Tp> * Tp(j) / Tp(len);
+                    roots[len/2+j] = std::polar(Tp(1),angle);
+                }
+            }
+            return roots;
+        }
+
+        template <typename Tp>
+        void butterflies(std::complex<Tp>* data, size_t n, std::complex<Tp> const* roots)
+        {
+            bit_reverse(data,n);
+            for (size_t len = 2; len <= n; len <<= 1)
+            {
+                auto const* w = roots + len/2;
+                for (size_t i = 0; i < n; i += len)
+                {
+                    for (size_t j = 0; j < len/2; ++j)
+                    {
+                        // by hand, since the library product guards against infinities
+                        auto const x = data[i+j+len/2];
+                        auto const v = std::complex<Tp>{
+                            x.real()*w[j].real() - x.imag()*w[j].imag(),
+                            x.real()*w[j].imag() + x.imag()*w[j].real()
+                        };
+                        auto const u = data[i+j];
+                        data[i+j] = u + v;
+                        data[i+j+len/2] = u - v;
+                    }
+                }
+            }
+        }
+
+        template <typename Tp>
+            requires std::is_floating_point<Tp>::value
+        void transform(std::span<std::complex<Tp>> data, bool inverse)
+        {
+            size_t const n = data.size();
+            auto const roots = complex_roots<Tp>(n);
+
+            butterflies(data.data(),n,roots.data());
+            if (inverse)
+            {
+                reverse_tail(data.data(),n);
+                for (auto& value : data) value /= Tp(n);
+            }
+        }
+
+        template <uint32_t P>
+        constexpr uint32_t power(uint64_t base, uint64_t exp)
+        {
+            uint64_t result = 1;
+            for (base %= P; exp; exp >>= 1, base = base * base % P)
+            {
+                if (exp & 1) result = result * base % P;
+            }
+            return uint32_t(result);
+        }
+
+        // twiddles modulo a prime, each with its Shoup quotient w 2^32 / p
+        template <typename Prime>
+        struct modular_roots
+        {
+            std::vector<uint32_t> roots;
+            std::vector<uint32_t> quotients;
+
+            explicit modular_roots(size_t n)
+                : roots(std::max<size_t>(n,2))
+                , quotients(std::max<size_t>(n,2))
+            {
+                constexpr uint32_t P = Prime::modulus;
+                for (size_t len = 2; len <= n; len <<= 1)
+                {
+                    auto const root = power<P>(Prime::generator,(P-1)/len);
+                    uint64_t w = 1;
+                    for (size_t j = 0; j < len/2; ++j, w = w * root % P)
+                    {
+                        roots[len/2+j] = uint32_t(w);
+                        quotients[len/2+j] = uint32_t((w << 32) / P);
+                    }
+                }
+            }
+        };
+
+        template <typename Prime>
+        void butterflies(uint32_t* data, size_t n, modular_roots<Prime> const& table)
+        {
+            constexpr uint32_t P = Prime::modulus;
+            bit_reverse(data,n);
+            for (size_t len = 2; len <= n; len <<= 1)
+            {
+                auto const* w = table.roots.data() + len/2;
+                auto const* q = table.quotients.data() + len/2;
+                for (size_t i = 0; i < n; i += len)
+                {
+                    for (size_t j = 0; j < len/2; ++j)
+                    {
+                        // x w mod p, in [0,2p) before the final correction
+                        uint32_t const x = data[i+j+len/2];
+                        uint32_t const quotient = uint32_t((uint64_t(x) * q[j]) >> 32);
+                        uint32_t v = x * w[j] - quotient * P;
+                        if (v >= P) v -= P;
+
+                        uint32_t const u = data[i+j];
+                        data[i+j] = (u + v >= P) ? u + v - P : u + v;
+                        data[i+j+len/2] = (u >= v) ? u - v : u + P - v;
+                    }
+                }
+            }
+        }
+
+        template <typename Prime>
+        void transform(std::span<uint32_t> data, bool inverse)
+        {
+            constexpr uint32_t P = Prime::modulus;
+            size_t const n = data.size();
+
+            butterflies(data.data(),n,modular_roots<Prime>{n});
+            if (inverse)
+            {
+                reverse_tail(data.data(),n);
+                auto const scale = power<P>(n,P-2);
+                for (auto& value : data) value = uint32_t(uint64_t(value) * scale % P);
+            }
+        }
+
+        template <typename Prime>
+        void multiply(std::span<uint32_t> result, std::span<uint32_t const> a, std::span<uint32_t const> b)
+        {
+            constexpr uint32_t P = Prime::modulus;
+            size_t const size = a.size() + b.size() - 1;
+            size_t const n = std::bit_ceil(size);
+            auto const table = modular_roots<Prime>{n};
+
+            std::vector<uint32_t> x(n), y(n);
+            std::copy(a.begin(),a.end(),x.begin());
+            std::copy(b.begin(),b.end(),y.begin());
+
+            butterflies(x.data(),n,table);
+            butterflies(y.data(),n,table);
+
+            // the scale of the inverse is folded into the pointwise product
+            auto const scale = power<P>(n,P-2);
+            for (size_t i = 0; i < n; ++i)
+            {
+                x[i] = uint32_t(uint64_t(x[i]) * y[i] % P * scale % P);
+            }
+            butterflies(x.data(),n,table);
+            reverse_tail(x.data(),n);
+            std::copy_n(x.begin(),size,result.begin());
+        }
+
+        template <typename Tp>
+            requires std::is_floating_point<Tp>::value
+        bool multiply(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b)
+        {
+            using Tv = std::conditional_t<(sizeof(Tp) < sizeof(double)),double,Tp>;
+            using Tc = std::complex<Tv>;
+
+            size_t const size = a.size() + b.size() - 1;
+            size_t const n = std::bit_ceil(size);
+
+            // integer-valued operands round to an exact product, provided
+            // the transform error stays below a half
+            auto const integral = [](auto const& values)
+            {
+                return std::all_of(values.begin(),values.end(),[](Tp v){ return v == std::nearbyint(v); });
+            };
+            auto const norm = [](auto const& values)
+            {
+                Tv sum = 0;
+                for (Tp v : values) sum += Tv(v) * Tv(v);
+                return std::sqrt(sum);
+            };
+            bool const exact = integral(a) && integral(b);
+            if (exact)
+            {
+                auto const error = norm(a) * norm(b) * std::numeric_limits<Tv>::epsilon()
+                    * Tv(8 * std::bit_width(n));
+                if (!(error < Tv(0.5))) return false;
+            }
+
+            // both operands in one transform, as the real and imaginary parts
+            std::vector<Tc> z(n), w(n);
+            for (size_t i = 0; i < a.size(); ++i) z[i].real(Tv(a[i]));
+            for (size_t i = 0; i < b.size(); ++i) z[i].imag(Tv(b[i]));
+
+            auto const roots = complex_roots<Tv>(n);
+            butterflies(z.data(),n,roots.data());
+
+            // A B = (Z(k)^2 - conj(Z(-k))^2) / 4i
+            for (size_t k = 0; k < n; ++k)
+            {
+                auto const zk = z[k];
+                auto const zj = std::conj(z[(n-k) & (n-1)]);
+                auto const re = zk.real()*zk.real() - zk.imag()*zk.imag() - zj.real()*zj.real() + zj.imag()*zj.imag();
+                auto const im = 2 * (zk.real()*zk.imag() - zj.real()*zj.imag());
+                w[k] = Tc{im / 4, -re / 4};
+            }
+            butterflies(w.data(),n,roots.data());
+            reverse_tail(w.data(),n);
+
+            for (size_t i = 0; i < size; ++i)
+            {
+                auto const value = w[i].real() / Tv(n);
+                result[i] = Tp(exact ? std::nearbyint(value) : value);
+            }
+            return true;
+        }
+
+        template <typename Tp>
+            requires std::is_integral<Tp>::value && (!std::is_same<Tp,bool>::value) && (sizeof(Tp) <= 8)
+        bool multiply(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b)
+        {
+            constexpr uint64_t p1 = prime1::modulus, p2 = prime2::modulus, p3 = prime3::modulus;
+            constexpr unsigned __int128 moduli[] = {p1, p1*p2, (unsigned __int128)(p1*p2) * p3};
+
+            size_t const size = a.size() + b.size() - 1;
+
+            {
+                // small operands round exactly from the complex transform,
+                // and large ones fail its error bound
+                auto const x = std::vector<double>(a.begin(),a.end());
+                auto const y = std::vector<double>(b.begin(),b.end());
+                std::vector<double> z(size);
+                if (multiply(std::span<double>{z},std::span<double const>{x},std::span<double const>{y}))
+                {
+                    std::transform(z.begin(),z.end(),result.begin(),[](double v){ return Tp(std::llround(v)); });
+                    return true;
+                }
+            }
+            if (std::min(a.size(),b.size()) < modular_threshold) return false;
+            if (std::bit_ceil(size) > prime1::max_size) return false;
+
+            // exact when every coefficient of the product lies within half
+            // the combined modulus, or below it for unsigned operands, and
+            // with as few primes as that needs
+            auto const magnitude = [](auto const& values)
+            {
+                uint64_t max = 0;
+                for (Tp v : values)
+                {
+                    uint64_t m = uint64_t(v);
+                    if constexpr (std::is_signed<Tp>::value) {
+                        if (v < 0) m = uint64_t(0) - m;
+                    }
+                    max = std::max(max,m);
+                }
+                return max;
+            };
+            auto const bound = (long double)(magnitude(a)) * (long double)(magnitude(b))
+                * (long double)(std::min(a.size(),b.size()));
+            auto const within = [&](unsigned __int128 modulus)
+            {
+                return bound < (long double)(modulus) / (std::is_signed<Tp>::value ? 2 : 1);
+            };
+            size_t const primes = within(moduli[0]) ? 1 : within(moduli[1]) ? 2 : within(moduli[2]) ? 3 : 0;
+            if (primes == 0) return false;
+
+            auto const residues = [&]<typename Prime>(Prime, std::span<Tp const> values)
+            {
+                std::vector<uint32_t> out(values.size());
+                for (size_t i = 0; i < values.size(); ++i)
+                {
+                    if constexpr (std::is_signed<Tp>::value) {
+                        auto const r = int64_t(values[i]) % int64_t(Prime::modulus);
+                        out[i] = uint32_t(r < 0 ? r + int64_t(Prime::modulus) : r);
+                    } else {
+                        out[i] = uint32_t(uint64_t(values[i]) % Prime::modulus);
+                    }
+                }
+                return out;
+            };
+            auto const product = [&]<typename Prime>(Prime prime)
+            {
+                auto const x = residues(prime,a);
+                auto const y = residues(prime,b);
+                std::vector<uint32_t> out(size);
+                multiply<Prime>(out,x,y);
+                return out;
+            };
+            auto const r1 = product(prime1{});
+            auto const r2 = (primes > 1) ? product(prime2{}) : std::vector<uint32_t>{};
+            auto const r3 = (primes > 2) ? product(prime3{}) : std::vector<uint32_t>{};
+
+            // Garner's recombination, x = x1 + x2 p1 + x3 p1 p2
+            constexpr uint64_t inv1 = power<prime2::modulus>(p1,p2-2);
+            constexpr uint64_t inv12 = power<prime3::modulus>(p1*p2 % p3,p3-2);
+            auto const modulus = moduli[primes-1];
+            for (size_t i = 0; i < size; ++i)
+            {
+                uint64_t const x1 = r1[i];
+                uint64_t const x2 = (primes > 1) ? (r2[i] + p2 - x1 % p2) % p2 * inv1 % p2 : 0;
+                uint64_t const x3 = (primes > 2) ? (r3[i] + p3 - (x1 + x2 * p1) % p3) % p3 * inv12 % p3 : 0;
+
+                auto const x = (unsigned __int128)(x1) + (unsigned __int128)(x2) * p1
+                    + (unsigned __int128)(x3) * (p1 * p2);
+                if (std::is_signed<Tp>::value && x > modulus / 2) {
+                    result[i] = Tp(uint64_t(0) - uint64_t(modulus - x));
+                } else {
+                    result[i] = Tp(uint64_t(x));
+                }
+            }
+            return true;
+        }
+
+    } // namespace fft
+
+} // namespace mpp
+
+#endif /* __HH_MPP_FFT */
@@ -0,0 +1,251 @@
+
+#ifndef __HH_MPP_GEMM
+#define __HH_MPP_GEMM
+
+#include "mathpp/parallel.hh"
+
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * A cache-blocked general matrix product, C += A * B, over strided
+     * operands of arithmetic type. Blocks of A and B are packed into
+     * contiguous panels sized for the caches, and then multiplied by a
+     * register-tiled micro-kernel.
+     */
+    namespace gemm
+    {
+
+        template <typename Tp>
+        struct layout
+        {
+            Tp* data;
+            size_t row_stride;
+            size_t col_stride;
+        };
+
+        template <typename Tp>
+        struct blocking
+        {
+            constexpr static size_t MR = 4;                     // register rows
+            constexpr static size_t NR = 64 / sizeof(Tp);       // register cols
+            constexpr static size_t KC = 256;                   // L1 depth
+            constexpr static size_t MC = 24 * MR;               // L2 rows
+            constexpr static size_t NC = 128 * NR;              // L3 cols
+        };
+
+        // products smaller than this many multiply-adds skip the packing
+        constexpr size_t threshold = 16 * 16 * 16;
+
+        template <typename Tp>
+        void multiply(size_t m, size_t n, size_t k,
+            layout<Tp const> a, layout<Tp const> b, layout<Tp> c);
+
+        // the same product, with panels of rows of C shared out by the policy
+        // against each packed block of B
+        template <typename Tp, execution_policy Policy>
+        void multiply(Policy const&, size_t m, size_t n, size_t k,
+            layout<Tp const> a, layout<Tp const> b, layout<Tp> c);
+
+    } // namespace gemm
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace gemm
+    {
+
+        template <typename Tp>
+        void pack_a(size_t mc, size_t kc, layout<Tp const> a, Tp* packed)
+        {
+            constexpr size_t MR = blocking<Tp>::MR;
+
+            // row panels of MR rows, stored column by column, zero padded
+            for (size_t i = 0; i < mc; i += MR)
+            {
+                size_t const mr = std::min(MR,mc-i);
+                for (size_t p = 0; p < kc; ++p)
+                {
+                    for (size_t ii = 0; ii < MR; ++ii)
+                    {
+                        *packed++ = (ii < mr)
+                            ? a.data[(i+ii)*a.row_stride + p*a.col_stride]
+                            : Tp{0};
+                    }
+                }
+            }
+        }
+
+        template <typename Tp>
+        void pack_b(size_t kc, size_t nc, layout<Tp const> b, Tp* packed)
+        {
+            constexpr size_t NR = blocking<Tp>::NR;
+
+            // column panels of NR columns, stored row by row, zero padded
+            for (size_t j = 0; j < nc; j += NR)
+            {
+                size_t const nr = std::min(NR,nc-j);
+                for (size_t p = 0; p < kc; ++p)
+                {
+                    for (size_t jj = 0; jj < NR; ++jj)
+                    {
+                        *packed++ = (jj < nr)
+                            ? b.data[p*b.row_stride + (j+jj)*b.col_stride]
+                            : Tp{0};
+                    }
+                }
+            }
+        }
+
+        template <typename Tp>
+        void kernel(size_t kc, Tp const* a, Tp const* b, layout<Tp> c, size_t mr, size_t nr)
+        {
+            constexpr size_t MR = blocking<Tp>::MR;
+            constexpr size_t NR = blocking<Tp>::NR;
+
+            Tp acc[MR][NR] = {};
+
+            for (size_t p = 0; p < kc; ++p)
+            {
+                for (size_t i = 0; i < MR; ++i)
+                {
+                    Tp const ai = a[p*MR+i];
+                    for (size_t j = 0; j < NR; ++j)
+                    {
+                        acc[i][j] += ai * b[p*NR+j];
+                    }
+                }
+            }
+            for (size_t i = 0; i < mr; ++i)
+            {
+                for (size_t j = 0; j < nr; ++j)
+                {
+                    c.data[i*c.row_stride + j*c.col_stride] += acc[i][j];
+                }
+            }
+        }
+
+        // C += A * B for one packed block of B, over blocks of the rows of A
+        template <typename Tp>
+        void multiply_packed(size_t m, size_t nc, size_t kc,
+            layout<Tp const> a, Tp const* packed_b, layout<Tp> c)
+        {
+            using blk = blocking<Tp>;
+
+            thread_local std::vector<Tp> packed_a;
+            packed_a.resize(blk::MC * blk::KC);
+
+            for (size_t ic = 0; ic < m; ic += blk::MC)
+            {
+                size_t const mc = std::min(blk::MC,m-ic);
+                auto const a_block = layout<Tp const>{
+                    a.data + ic*a.row_stride, a.row_stride, a.col_stride
+                };
+                pack_a(mc,kc,a_block,packed_a.data());
+
+                for (size_t jr = 0; jr < nc; jr += blk::NR)
+                {
+                    for (size_t ir = 0; ir < mc; ir += blk::MR)
+                    {
+                        auto const c_tile = layout<Tp>{
+                            c.data + (ic+ir)*c.row_stride + jr*c.col_stride,
+                            c.row_stride, c.col_stride
+                        };
+                        kernel(kc,
+                            packed_a.data() + ir*kc,
+                            packed_b + jr*kc,
+                            c_tile,
+                            std::min(blk::MR,mc-ir),
+                            std::min(blk::NR,nc-jr)
+                        );
+                    }
+                }
+            }
+        }
+
+        template <typename Tp>
+        void multiply(size_t m, size_t n, size_t k,
+            layout<Tp const> a, layout<Tp const> b, layout<Tp> c)
+        {
+            using blk = blocking<Tp>;
+
+            thread_local std::vector<Tp> packed_b;
+            packed_b.resize(blk::KC * blk::NC);
+
+            for (size_t jc = 0; jc < n; jc += blk::NC)
+            {
+                size_t const nc = std::min(blk::NC,n-jc);
+                for (size_t pc = 0; pc < k; pc += blk::KC)
+                {
+                    size_t const kc = std::min(blk::KC,k-pc);
+                    auto const b_block = layout<Tp const>{
+                        b.data + pc*b.row_stride + jc*b.col_stride, b.row_stride, b.col_stride
+                    };
+                    pack_b(kc,nc,b_block,packed_b.data());
+
+                    multiply_packed<Tp>(m,nc,kc,
+                        {a.data + pc*a.col_stride, a.row_stride, a.col_stride},
+                        packed_b.data(),
+                        {c.data + jc*c.col_stride, c.row_stride, c.col_stride});
+                }
+            }
+        }
+
+        template <typename Tp, execution_policy Policy>
+        void multiply(Policy const& policy, size_t m, size_t n, size_t k,
+            layout<Tp const> a, layout<Tp const> b, layout<Tp> c)
+        {
+            using blk = blocking<Tp>;
+
+            // each block of B is packed once and read by every panel of rows;
+            // not thread-local, as a thread waiting on the panels may run
+            // another product's tasks in the meantime
+            std::vector<Tp> packed_b(blk::KC * blk::NC);
+
+            // whole register tiles per panel, and every element of C summed
+            // over k in the same order as when sequenced
+            size_t const panels = (m + blk::MR - 1) / blk::MR;
+
+            for (size_t jc = 0; jc < n; jc += blk::NC)
+            {
+                size_t const nc = std::min(blk::NC,n-jc);
+                for (size_t pc = 0; pc < k; pc += blk::KC)
+                {
+                    size_t const kc = std::min(blk::KC,k-pc);
+                    auto const b_block = layout<Tp const>{
+                        b.data + pc*b.row_stride + jc*b.col_stride, b.row_stride, b.col_stride
+                    };
+                    pack_b(kc,nc,b_block,packed_b.data());
+
+                    policy.for_each(0,panels,1,[&](size_t lo, size_t hi)
+                    {
+                        size_t const row = lo * blk::MR;
+                        size_t const rows = std::min(hi * blk::MR,m) - row;
+                        multiply_packed<Tp>(rows,nc,kc,
+                            {a.data + row*a.row_stride + pc*a.col_stride, a.row_stride, a.col_stride},
+                            packed_b.data(),
+                            {c.data + row*c.row_stride + jc*c.col_stride, c.row_stride, c.col_stride});
+                    });
+                }
+            }
+        }
+
+    } // namespace gemm
+
+} // namespace mpp
+
+#endif /* __HH_MPP_GEMM */
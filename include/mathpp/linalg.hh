@@ -4,13 +4,24 @@
 
 #include <mathpp/matrix.hh>
 #include <mathpp/vector.hh>
+#include <mathpp/view.hh>
 
 namespace mpp
 {
 
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-    auto operator*(Matrix<Tp,Nr,Nc> const& matrix, Vector<Tq,Nc> const& vector)
+    /*
+     * Products of matrices and vectors take owning containers and views alike,
+     * so rows, columns and blocks are multiplied in place.
+     */
+    template <typename Mx, typename Vx>
+        requires matrix_operand<Mx> && vector_operand<Vx,true>
+            && (std::remove_cvref_t<Mx>::cols() == std::remove_cvref_t<Vx>::size())
+    auto operator*(Mx const& matrix, Vx const& vector)
     {
+        using Tp = expression_value_t<Mx>;
+        using Tq = expression_value_t<Vx>;
+        constexpr size_t Nr = Mx::rows(), Nc = Mx::cols();
+
         using Tr = op_mul::result<Tp,Tq>::type;
         Vector<Tr,Nr> result = identity<Vector<Tr,Nr>,op_add>::get();
 
@@ -24,9 +35,15 @@ namespace mpp
         return result;
     }
 
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-    auto operator*(CoVector<Tp,Nr> const& covector, Matrix<Tq,Nr,Nc> const& matrix)
+    template <typename Vx, typename Mx>
+        requires vector_operand<Vx,false> && matrix_operand<Mx>
+            && (std::remove_cvref_t<Vx>::size() == std::remove_cvref_t<Mx>::rows())
+    auto operator*(Vx const& covector, Mx const& matrix)
     {
+        using Tp = expression_value_t<Vx>;
+        using Tq = expression_value_t<Mx>;
+        constexpr size_t Nr = Mx::rows(), Nc = Mx::cols();
+
         using Tr = op_mul::result<Tp,Tq>::type;
         CoVector<Tr,Nc> result = identity<CoVector<Tr,Nc>,op_add>::get();
 
@@ -40,9 +57,14 @@ namespace mpp
         return result;
     }
 
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-    auto operator*(Vector<Tp,Nr> const& vector, CoVector<Tq,Nc> const& covector)
+    template <typename Vx, typename Cx>
+        requires vector_operand<Vx,true> && vector_operand<Cx,false>
+    auto operator*(Vx const& vector, Cx const& covector)
     {
+        using Tp = expression_value_t<Vx>;
+        using Tq = expression_value_t<Cx>;
+        constexpr size_t Nr = Vx::size(), Nc = Cx::size();
+
         using Tr = op_mul::result<Tp,Tq>::type;
         Matrix<Tr,Nr,Nc> result = identity<Matrix<Tr,Nr,Nc>,op_add>::get();
 
@@ -56,9 +78,15 @@ namespace mpp
         return result;
     }
 
-    template <typename Tp, typename Tq, size_t Nm>
-    auto operator*(CoVector<Tp,Nm> const& covector, Vector<Tq,Nm> const& vector)
+    template <typename Cx, typename Vx>
+        requires vector_operand<Cx,false> && vector_operand<Vx,true>
+            && (std::remove_cvref_t<Cx>::size() == std::remove_cvref_t<Vx>::size())
+    auto operator*(Cx const& covector, Vx const& vector)
     {
+        using Tp = expression_value_t<Cx>;
+        using Tq = expression_value_t<Vx>;
+        constexpr size_t Nm = Vx::size();
+
         using Tr = op_mul::result<Tp,Tq>::type;
         Tr result = identity<Tr,op_add>::get();
 
@@ -3,10 +3,17 @@
 #define __HH_MPP_MATRIX
 
 #include "mathpp/mathpp.hh"
+#include "mathpp/storage.hh"
+#include "mathpp/expr.hh"
+#include "mathpp/simd.hh"
+#include "mathpp/gemm.hh"
+#include "mathpp/parallel.hh"
 
-#include <vector>
 #include <array>
 #include <span>
+#include <tuple>
+#include <utility>
+#include <algorithm>
 #include <stdexcept>
 
 /* ************************************************************************** */
@@ -20,88 +27,266 @@ namespace mpp
     class Matrix
     {
     public:
-        explicit Matrix();
-        explicit Matrix(Tp const&);
-        explicit Matrix(std::span<Tp,Nr*Nc> const&);
-        virtual ~Matrix() = default;
+        constexpr explicit Matrix();
+        constexpr explicit Matrix(Tp const&);
+        constexpr explicit Matrix(std::span<Tp,Nr*Nc> const&);
 
         template <typename... Args>
             requires (std::conjunction<std::is_convertible<Args,Tp>...>::value)
                 && (sizeof...(Args) == Nr*Nc)
-        Matrix(Args const&... args);
+        constexpr Matrix(Args const&... args);
 
         template <typename... Args>
             requires (std::conjunction<std::is_same<Args,Tp>...>::value)
                 && (sizeof...(Args) == Nr*Nc)
-        Matrix(Args&&... args);
+        constexpr Matrix(Args&&... args);
 
         template <typename Tq>
             requires (std::is_convertible<Tq,Tp>::value)
-        Matrix(Matrix<Tq,Nr,Nc> const&);
+        constexpr Matrix(Matrix<Tq,Nr,Nc> const&);
+
+        template <typename E>
+            requires expression_proxy<E> && same_shape<E,Matrix<Tp,Nr,Nc>>
+        constexpr Matrix(E const&);
 
         template <typename Tq>
             requires (std::is_convertible<Tq,Tp>::value)
-        Matrix<Tp,Nr,Nc>& operator=(Matrix<Tq,Nr,Nc> const&);
+        constexpr Matrix<Tp,Nr,Nc>& operator=(Matrix<Tq,Nr,Nc> const&);
+
+        template <typename E>
+            requires expression_proxy<E> && same_shape<E,Matrix<Tp,Nr,Nc>>
+        constexpr Matrix<Tp,Nr,Nc>& operator=(E const&);
 
-        void swap(Matrix<Tp,Nr,Nc>&);
+        constexpr void swap(Matrix<Tp,Nr,Nc>&);
 
     public:
         constexpr static size_t index(std::array<size_t,2> const&);
         constexpr static auto rows() { return Nr; }
         constexpr static auto cols() { return Nc; }
-        auto elements() const -> std::vector<Tp> const& { return m_Elements; }
+        constexpr static auto size() { return Nr*Nc; }
+        constexpr auto elements() const -> std::array<Tp,Nr*Nc> const& { return m_Elements.array(); }
+        constexpr auto data() const -> Tp const* { return m_Elements.data(); }
+        constexpr auto data() -> Tp* { return m_Elements.data(); }
 
-        void assign(Tp const&);
+        constexpr void assign(Tp const&);
 
         template <typename... Args>
             requires (std::conjunction<std::is_convertible<Args,Tp>...>::value)
                 && (sizeof...(Args) == Nr*Nc)
-        void assign(Args&&... args);
+        constexpr void assign(Args&&... args);
 
         Tp determinant() const requires (Nr == Nc != 0);
         Tp trace() const requires (Nr == Nc != 0);
 
-        auto operator[](size_t index) const -> Tp const& { return m_Elements[index]; }
-        auto operator[](size_t index) -> Tp& { return m_Elements[index]; }
-        auto at(size_t index) const -> Tp const& { return m_Elements.at(index); }
-        auto at(size_t index) -> Tp& { return m_Elements.at(index); }
-
-        auto operator[](std::array<size_t,2> const&) const -> Tp const&;
-        auto operator[](std::array<size_t,2> const&) -> Tp&;
-        auto at(std::array<size_t,2> const&) const -> Tp const&;
-        auto at(std::array<size_t,2> const&) -> Tp&;
-
-        template <typename Tq>
-        Matrix<Tp,Nr,Nc>& operator+=(Matrix<Tq,Nr,Nc> const&);
-        template <typename Tq>
-        Matrix<Tp,Nr,Nc>& operator-=(Matrix<Tq,Nr,Nc> const&);
+        constexpr auto operator[](size_t index) const -> Tp const& { return m_Elements[index]; }
+        constexpr auto operator[](size_t index) -> Tp& { return m_Elements[index]; }
+        constexpr auto at(size_t index) const -> Tp const&;
+        constexpr auto at(size_t index) -> Tp&;
+
+        constexpr auto operator[](std::array<size_t,2> const&) const -> Tp const&;
+        constexpr auto operator[](std::array<size_t,2> const&) -> Tp&;
+        constexpr auto at(std::array<size_t,2> const&) const -> Tp const&;
+        constexpr auto at(std::array<size_t,2> const&) -> Tp&;
+
+        template <typename E>
+            requires same_shape<E,Matrix<Tp,Nr,Nc>>
+        constexpr Matrix<Tp,Nr,Nc>& operator+=(E const&);
+        template <typename E>
+            requires same_shape<E,Matrix<Tp,Nr,Nc>>
+        constexpr Matrix<Tp,Nr,Nc>& operator-=(E const&);
         template <typename Tq>
-        Matrix<Tp,Nr,Nc>& operator*=(Tq const&);
+            requires (!expression<Tq>)
+        constexpr Matrix<Tp,Nr,Nc>& operator*=(Tq const&);
         template <typename Tq>
-        Matrix<Tp,Nr,Nc>& operator/=(Tq const&);
+            requires (!expression<Tq>)
+        constexpr Matrix<Tp,Nr,Nc>& operator/=(Tq const&);
         template <typename Tq>
-        Matrix<Tp,Nr,Nc>& operator%=(Tq const&);
+            requires (!expression<Tq>)
+        constexpr Matrix<Tp,Nr,Nc>& operator%=(Tq const&);
 
     private:
-        std::vector<Tp> m_Elements{};
+        Storage<Tp,Nr*Nc> m_Elements{};
     };
 
     namespace matrices
     {
 
         template <typename Tp, size_t Nr, size_t Nc>
-        auto submatrix(Matrix<Tp,Nr,Nc> const&, size_t, size_t);
+        constexpr auto submatrix(Matrix<Tp,Nr,Nc> const&, size_t, size_t);
+
+        /*
+         * Whether `Tp` is an integral domain whose division recovers the
+         * quotient of an exact multiple, as Bareiss elimination needs. The
+         * unsigned integers wrap, and lose this once a minor wraps around, so
+         * only the signed integers are declared. Other exact rings may
+         * specialise it.
+         */
+        template <typename Tp>
+        struct exact_division : std::bool_constant<std::is_integral<Tp>::value
+            && std::is_signed<Tp>::value && division<Tp,Tp>::has() == logic::all>
+        {};
+
+        /*
+         * The determinant, by partially pivoted LU elimination when `Tp` is a
+         * field, by fraction-free Bareiss elimination when `Tp` has exact
+         * division, and by cofactor expansion otherwise.
+         */
+        template <typename Tp, size_t Nm>
+        constexpr auto determinant(Matrix<Tp,Nm,Nm> const&) -> Tp;
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        constexpr auto determinant_lu(Matrix<Tp,Nm,Nm> const&) -> Tp;
+
+        template <typename Tp, size_t Nm>
+            requires (exact_division<Tp>::value)
+        constexpr auto determinant_bareiss(Matrix<Tp,Nm,Nm> const&) -> Tp;
 
         template <typename Tp, size_t Nm>
-        auto determinant(Matrix<Tp,Nm,Nm> const&) -> Tp;
+        constexpr auto determinant_cofactor(Matrix<Tp,Nm,Nm> const&) -> Tp;
 
         template <typename Tp, size_t Nm>
-        auto trace(Matrix<Tp,Nm,Nm> const&) -> Tp;
+        constexpr auto trace(Matrix<Tp,Nm,Nm> const&) -> Tp;
+
+        /*
+         * Elimination kernels over a row-major square array of order `n`,
+         * shared by matrices of every shape. Right-hand sides are row-major
+         * with `nk` columns for `lu_solve`, and `nk` rows for `lu_rsolve`.
+         */
+        template <typename Tp>
+        constexpr bool lu_factor(Tp* a, size_t n, size_t* pivots, Tp* reciprocals, bool& odd);
+
+        template <typename Tp>
+        constexpr void lu_solve(Tp const* a, size_t n, size_t const* pivots, Tp const* reciprocals, Tp* b, size_t nk);
+
+        template <typename Tp>
+        constexpr void lu_rsolve(Tp const* a, size_t n, size_t const* pivots, Tp const* reciprocals, Tp* b, size_t nk);
+
+        template <typename Tp>
+        constexpr auto bareiss(Tp* a, size_t n) -> Tp;
+
+        template <typename Tp>
+        constexpr void gauss_jordan(Tp* a, size_t n, Tp* b);
+
+        /*
+         * The same kernels under an execution policy. Elimination shares out
+         * the rows below the pivot at every step, and substitution shares out
+         * the columns of the right-hand side.
+         */
+        template <execution_policy Policy, typename Tp>
+        constexpr bool lu_factor(Policy const&, Tp* a, size_t n, size_t* pivots, Tp* reciprocals, bool& odd);
+
+        template <execution_policy Policy, typename Tp>
+        constexpr void lu_solve(Policy const&, Tp const* a, size_t n, size_t const* pivots, Tp const* reciprocals, Tp* b, size_t nk);
+
+        template <execution_policy Policy, typename Tp>
+        constexpr auto bareiss(Policy const&, Tp* a, size_t n) -> Tp;
+
+        template <execution_policy Policy, typename Tp>
+        constexpr void gauss_jordan(Policy const&, Tp* a, size_t n, Tp* b);
+
+        /*
+         * The product, determinant and inverse under an execution policy.
+         */
+        template <execution_policy Policy, typename Tp, size_t Nr, size_t Nc, size_t Nz>
+        constexpr auto multiply(Policy const&, Matrix<Tp,Nr,Nc> const&, Matrix<Tp,Nc,Nz> const&) -> Matrix<Tp,Nr,Nz>;
+
+        template <execution_policy Policy, typename Tp, size_t Nm>
+        constexpr auto determinant(Policy const&, Matrix<Tp,Nm,Nm> const&) -> Tp;
+
+        template <execution_policy Policy, typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() != logic::none)
+        constexpr auto invert(Policy const&, Matrix<Tp,Nm,Nm> const&) -> Matrix<Tp,Nm,Nm>;
+
+        /*
+         * A partially pivoted factorisation PA = LU of a square matrix over a
+         * field, factored once and then reused to solve any number of
+         * right-hand sides by forward and back substitution. Right-hand sides
+         * may be matrices of columns, single vectors, or batches of vectors.
+         */
+        template <typename Tp, size_t Nm = std::dynamic_extent>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        class LU
+        {
+        public:
+            constexpr explicit LU(Matrix<Tp,Nm,Nm> const&);
+
+            template <execution_policy Policy>
+            constexpr LU(Policy const&, Matrix<Tp,Nm,Nm> const&);
+
+        public:
+            constexpr bool singular() const { return m_Singular; }
+            constexpr auto factors() const -> Matrix<Tp,Nm,Nm> const& { return m_Factors; }
+            constexpr auto pivots() const -> std::array<size_t,Nm> const& { return m_Pivots; }
+
+            constexpr auto determinant() const -> Tp;
+            constexpr auto inverse() const -> Matrix<Tp,Nm,Nm>;
+
+            template <execution_policy Policy>
+            constexpr auto inverse(Policy const&) const -> Matrix<Tp,Nm,Nm>;
+
+            // solves A X = B
+            template <size_t Nk>
+            constexpr auto solve(Matrix<Tp,Nm,Nk> const&) const -> Matrix<Tp,Nm,Nk>;
+
+            template <execution_policy Policy, size_t Nk>
+            constexpr auto solve(Policy const&, Matrix<Tp,Nm,Nk> const&) const -> Matrix<Tp,Nm,Nk>;
+
+            // solves A x = b
+            template <typename Bv>
+                requires (Bv::size() == Nm) && requires (Bv b) { { b.data() } -> std::same_as<Tp*>; }
+            constexpr auto solve(Bv const&) const -> Bv;
+
+            // solves A x = b in place, for every b in the batch
+            template <typename Bv>
+                requires (Bv::size() == Nm) && requires (Bv b) { { b.data() } -> std::same_as<Tp*>; }
+            constexpr void solve(std::span<Bv>) const;
+
+            // solves X A = B
+            template <size_t Nk>
+            constexpr auto rsolve(Matrix<Tp,Nk,Nm> const&) const -> Matrix<Tp,Nk,Nm>;
+
+        private:
+            constexpr void validate() const;
+
+        private:
+            Matrix<Tp,Nm,Nm> m_Factors;
+            std::array<Tp,Nm> m_Reciprocals{};
+            std::array<size_t,Nm> m_Pivots{};
+            bool m_Odd = false;
+            bool m_Singular = false;
+        };
+
+        // the factorisation of matrices of runtime order, in dynmatrix.hh
+        template <typename Tp>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        class LU<Tp,std::dynamic_extent>;
 
     } // namespace matrices
 
 } // namespace mpp
 
+/* ************************************************************************** */
+// Expression Specialisations
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    struct expression_traits<Matrix<Tp,Nr,Nc>>
+    {
+        using value_type = Tp;
+        using result_type = Matrix<Tp,Nr,Nc>;
+
+        template <typename Tr>
+        using rebind = Matrix<Tr,Nr,Nc>;
+
+        constexpr static size_t size = Nr*Nc;
+    };
+
+} // namespace mpp
+
 /* ************************************************************************** */
 // MathPP Specialisations
 /* ************************************************************************** */
@@ -188,51 +373,17 @@ namespace mpp
         }
         constexpr static Matrix<Tp,Nm,Nm> get(Matrix<Tp,Nm,Nm> const& matrix)
         {
-            Matrix<Tp,Nm,Nm> source = matrix;
-            Matrix<Tp,Nm,Nm> result = identity<Matrix<Tp,Nm,Nm>,op_mul>::get();
-            Tp multiplier;
-
-            // gaussian elimination
-            for (size_t k = 0; k < Nm; ++k)
+            if constexpr (inverse<Tp,op_mul>::has() == logic::all)
             {
-                multiplier = inverse<Tp,op_mul>::get(source[{k,k}]);
-                for (size_t j = Nm-1; j < Nm; --j)
-                {
-                    source[{k,j}] *= multiplier;
-                    result[{k,j}] *= multiplier;
-                }
-                for (size_t i = k+1; i < Nm; ++i)
-                {
-                    multiplier = source[{i,k}];
-                    for (size_t j = Nm-1; j < Nm; --j)
-                    {
-                        source[{i,j}] -= multiplier * source[{k,j}];
-                        result[{i,j}] -= multiplier * result[{k,j}];
-                    }
-                }
+                return matrices::LU<Tp,Nm>{matrix}.inverse();
             }
-
-            // jordan elimination
-            for (size_t k = Nm-1; k < Nm; --k)
+            else
             {
-                multiplier = inverse<Tp,op_mul>::get(source[{k,k}]);
-                for (size_t j = 0; j < Nm; ++j)
-                {
-                    source[{k,j}] *= multiplier;
-                    result[{k,j}] *= multiplier;
-                }
-                for (size_t i = k-1; i < Nm; --i)
-                {
-                    multiplier = source[{i,k}];
-                    for (size_t j = 0; j < Nm; ++j)
-                    {
-                        source[{i,j}] -= multiplier * source[{k,j}];
-                        result[{i,j}] -= multiplier * result[{k,j}];
-                    }
-                }
+                Matrix<Tp,Nm,Nm> source = matrix;
+                Matrix<Tp,Nm,Nm> result = identity<Matrix<Tp,Nm,Nm>,op_mul>::get();
+                matrices::gauss_jordan(source.data(),Nm,result.data());
+                return result;
             }
-
-            return result;
         }
         constexpr static Matrix<Tp,Nm,Nm>& make(Matrix<Tp,Nm,Nm>& matrix)
         {
@@ -253,25 +404,52 @@ namespace mpp
     {
 
         template <typename Tp, size_t Nr, size_t Nc>
-        auto submatrix(Matrix<Tp,Nr,Nc> const& matrix, size_t i, size_t j)
+        constexpr auto submatrix(Matrix<Tp,Nr,Nc> const& matrix, size_t i, size_t j)
         {
-            constexpr auto size = (Nr-1)*(Nc-1);
-            std::vector<Tp> elements;
-            elements.reserve(size);
+            Matrix<Tp,Nr-1,Nc-1> result;
 
+            size_t index = 0;
             for (size_t m = 0; m < Nr; ++m) {
                 if (m == i) continue;
                 for (size_t n = 0; n < Nc; ++n) {
                     if (n == j) continue;
-                    elements.push_back(matrix[{m,n}]);
+                    result[index++] = matrix[{m,n}];
                 }
             }
-            auto const span = std::span<Tp,size>{elements.begin(),elements.end()};
-            return Matrix<Tp,Nr-1,Nc-1>{span};
+            return result;
+        }
+
+        template <typename Tp, size_t Nm>
+        constexpr auto determinant(Matrix<Tp,Nm,Nm> const& matrix) -> Tp
+        {
+            if constexpr (inverse<Tp,op_mul>::has() == logic::all) {
+                return determinant_lu(matrix);
+            } else if constexpr (exact_division<Tp>::value) {
+                return determinant_bareiss(matrix);
+            } else {
+                static_assert(inverse<Tp,op_add>::has() != logic::none,
+                    "mpp::matrices::determinant needs exact division or additive inverses");
+                return determinant_cofactor(matrix);
+            }
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        constexpr auto determinant_lu(Matrix<Tp,Nm,Nm> const& matrix) -> Tp
+        {
+            return LU<Tp,Nm>{matrix}.determinant();
         }
 
         template <typename Tp, size_t Nm>
-        auto determinant(Matrix<Tp,Nm,Nm> const& matrix) -> Tp
+            requires (exact_division<Tp>::value)
+        constexpr auto determinant_bareiss(Matrix<Tp,Nm,Nm> const& matrix) -> Tp
+        {
+            auto copy = matrix;
+            return bareiss(copy.data(),Nm);
+        }
+
+        template <typename Tp, size_t Nm>
+        constexpr auto determinant_cofactor(Matrix<Tp,Nm,Nm> const& matrix) -> Tp
         {
             if constexpr (Nm == 1)
             {
@@ -284,7 +462,7 @@ namespace mpp
                 auto multiplier = identity<Tp,op_mul>::get();
                 for (size_t i = 0; i < Nm; ++i)
                 {
-                    auto const det = determinant(submatrix(matrix,i,0));
+                    auto const det = determinant_cofactor(submatrix(matrix,i,0));
                     result += multiplier * det * matrix[{i,0}];
                     inverse<Tp,op_add>::make(multiplier);
                 }
@@ -293,7 +471,7 @@ namespace mpp
         }
 
         template <typename Tp, size_t Nm>
-        auto trace(Matrix<Tp,Nm,Nm> const& matrix) -> Tp
+        constexpr auto trace(Matrix<Tp,Nm,Nm> const& matrix) -> Tp
         {
             Tp result = identity<Tp,op_add>::get();
 
@@ -304,6 +482,408 @@ namespace mpp
             return result;
         }
 
+        template <typename Tp>
+        constexpr bool lu_factor(Tp* a, size_t n, size_t* pivots, Tp* reciprocals, bool& odd)
+        {
+            return lu_factor(execution::seq,a,n,pivots,reciprocals,odd);
+        }
+
+        template <typename Tp>
+        constexpr void lu_solve(Tp const* a, size_t n, size_t const* pivots, Tp const* reciprocals, Tp* b, size_t nk)
+        {
+            lu_solve(execution::seq,a,n,pivots,reciprocals,b,nk);
+        }
+
+        template <typename Tp>
+        constexpr auto bareiss(Tp* a, size_t n) -> Tp
+        {
+            return bareiss(execution::seq,a,n);
+        }
+
+        template <typename Tp>
+        constexpr void gauss_jordan(Tp* a, size_t n, Tp* b)
+        {
+            gauss_jordan(execution::seq,a,n,b);
+        }
+
+        template <execution_policy Policy, typename Tp>
+        constexpr bool lu_factor(Policy const& policy, Tp* a, size_t n, size_t* pivots, Tp* reciprocals, bool& odd)
+        {
+            auto const zero = identity<Tp,op_add>::get();
+            bool singular = false;
+            odd = false;
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                // partial pivoting, on magnitude where there is one
+                size_t pivot = k;
+                for (size_t i = k+1; i < n; ++i)
+                {
+                    if constexpr (absolute<Tp,op_add>::has() != logic::none) {
+                        if (absolute<Tp,op_add>::get(a[pivot*n+k])
+                            < absolute<Tp,op_add>::get(a[i*n+k])) pivot = i;
+                    } else {
+                        if (a[pivot*n+k] == zero) pivot = i;
+                    }
+                }
+                pivots[k] = pivot;
+
+                if (pivot != k)
+                {
+                    std::swap_ranges(a+k*n,a+(k+1)*n,a+pivot*n);
+                    odd = !odd;
+                }
+                if (a[k*n+k] == zero)
+                {
+                    singular = true;
+                    continue;
+                }
+                reciprocals[k] = inverse<Tp,op_mul>::get(a[k*n+k]);
+
+                // the multipliers of L are kept below the diagonal of U
+                policy.for_each(k+1,n,execution::grain_for(n-k),[&](size_t lo, size_t hi)
+                {
+                    for (size_t i = lo; i < hi; ++i)
+                    {
+                        auto const factor = a[i*n+k] * reciprocals[k];
+                        a[i*n+k] = factor;
+                        for (size_t j = k+1; j < n; ++j)
+                        {
+                            a[i*n+j] -= factor * a[k*n+j];
+                        }
+                    }
+                });
+            }
+            return !singular;
+        }
+
+        template <execution_policy Policy, typename Tp>
+        constexpr void lu_solve(Policy const& policy, Tp const* a, size_t n, size_t const* pivots, Tp const* reciprocals, Tp* b, size_t nk)
+        {
+            // the columns of b are independent, so each panel is solved whole
+            policy.for_each(0,nk,execution::grain_for(n*n),[&](size_t lo, size_t hi)
+            {
+                // rows at a time, so that the inner loops run along rows of b
+                for (size_t k = 0; k < n; ++k)
+                {
+                    if (pivots[k] != k) std::swap_ranges(b+k*nk+lo,b+k*nk+hi,b+pivots[k]*nk+lo);
+                }
+                for (size_t i = 1; i < n; ++i)
+                {
+                    for (size_t k = 0; k < i; ++k)
+                    {
+                        auto const& factor = a[i*n+k];
+                        for (size_t j = lo; j < hi; ++j)
+                        {
+                            b[i*nk+j] -= factor * b[k*nk+j];
+                        }
+                    }
+                }
+                for (size_t i = n-1; i < n; --i)
+                {
+                    for (size_t k = i+1; k < n; ++k)
+                    {
+                        auto const& factor = a[i*n+k];
+                        for (size_t j = lo; j < hi; ++j)
+                        {
+                            b[i*nk+j] -= factor * b[k*nk+j];
+                        }
+                    }
+                    for (size_t j = lo; j < hi; ++j)
+                    {
+                        b[i*nk+j] *= reciprocals[i];
+                    }
+                }
+            });
+        }
+
+        template <typename Tp>
+        constexpr void lu_rsolve(Tp const* a, size_t n, size_t const* pivots, Tp const* reciprocals, Tp* b, size_t nk)
+        {
+            // X P^T L U = B, a row of B at a time
+            for (size_t r = 0; r < nk; ++r)
+            {
+                Tp* x = b + r*n;
+                for (size_t j = 0; j < n; ++j)
+                {
+                    for (size_t i = 0; i < j; ++i)
+                    {
+                        x[j] -= x[i] * a[i*n+j];
+                    }
+                    x[j] *= reciprocals[j];
+                }
+                for (size_t j = n-1; j < n; --j)
+                {
+                    for (size_t i = j+1; i < n; ++i)
+                    {
+                        x[j] -= x[i] * a[i*n+j];
+                    }
+                }
+                for (size_t k = n-1; k < n; --k)
+                {
+                    if (pivots[k] != k) std::swap(x[k],x[pivots[k]]);
+                }
+            }
+        }
+
+        template <execution_policy Policy, typename Tp>
+        constexpr auto bareiss(Policy const& policy, Tp* a, size_t n) -> Tp
+        {
+            auto const zero = identity<Tp,op_add>::get();
+            Tp previous = identity<Tp,op_mul>::get();
+            bool negate = false;
+
+            for (size_t k = 0; k < n; ++k)
+            {
+                size_t pivot = k;
+                while (pivot < n && a[pivot*n+k] == zero) ++pivot;
+                if (pivot == n) return zero;
+
+                if (pivot != k)
+                {
+                    std::swap_ranges(a+k*n+k,a+(k+1)*n,a+pivot*n+k);
+                    negate = !negate;
+                }
+
+                // every update divides exactly by the previous pivot
+                policy.for_each(k+1,n,execution::grain_for(2*(n-k)),[&](size_t lo, size_t hi)
+                {
+                    for (size_t i = lo; i < hi; ++i)
+                    {
+                        for (size_t j = k+1; j < n; ++j)
+                        {
+                            auto const minor = a[k*n+k] * a[i*n+j] - a[i*n+k] * a[k*n+j];
+                            a[i*n+j] = std::get<1>(division<Tp,Tp>::get(minor,previous));
+                        }
+                    }
+                });
+                previous = a[k*n+k];
+            }
+            return negate ? zero - previous : previous;
+        }
+
+        template <execution_policy Policy, typename Tp>
+        constexpr void gauss_jordan(Policy const& policy, Tp* a, size_t n, Tp* b)
+        {
+            auto const grain = execution::grain_for(2*n);
+
+            // gaussian elimination
+            for (size_t k = 0; k < n; ++k)
+            {
+                auto const multiplier = inverse<Tp,op_mul>::get(a[k*n+k]);
+                for (size_t j = n-1; j < n; --j)
+                {
+                    a[k*n+j] *= multiplier;
+                    b[k*n+j] *= multiplier;
+                }
+                policy.for_each(k+1,n,grain,[&](size_t lo, size_t hi)
+                {
+                    for (size_t i = lo; i < hi; ++i)
+                    {
+                        auto const factor = a[i*n+k];
+                        for (size_t j = n-1; j < n; --j)
+                        {
+                            a[i*n+j] -= factor * a[k*n+j];
+                            b[i*n+j] -= factor * b[k*n+j];
+                        }
+                    }
+                });
+            }
+
+            // jordan elimination
+            for (size_t k = n-1; k < n; --k)
+            {
+                auto const multiplier = inverse<Tp,op_mul>::get(a[k*n+k]);
+                for (size_t j = 0; j < n; ++j)
+                {
+                    a[k*n+j] *= multiplier;
+                    b[k*n+j] *= multiplier;
+                }
+                policy.for_each(0,k,grain,[&](size_t lo, size_t hi)
+                {
+                    for (size_t i = lo; i < hi; ++i)
+                    {
+                        auto const factor = a[i*n+k];
+                        for (size_t j = 0; j < n; ++j)
+                        {
+                            a[i*n+j] -= factor * a[k*n+j];
+                            b[i*n+j] -= factor * b[k*n+j];
+                        }
+                    }
+                });
+            }
+        }
+
+        template <execution_policy Policy, typename Tp, size_t Nr, size_t Nc, size_t Nz>
+        constexpr auto multiply(Policy const& policy, Matrix<Tp,Nr,Nc> const& matrix1, Matrix<Tp,Nc,Nz> const& matrix2) -> Matrix<Tp,Nr,Nz>
+        {
+            Matrix<Tp,Nr,Nz> result {identity<Tp,op_add>::get()};
+
+            if constexpr (std::is_arithmetic<Tp>::value && !std::is_same<Tp,bool>::value
+                && Nr*Nc*Nz >= gemm::threshold)
+            {
+                if (!std::is_constant_evaluated())
+                {
+                    gemm::multiply<Tp>(policy,Nr,Nz,Nc,
+                        {matrix1.data(),Nc,1}, {matrix2.data(),Nz,1}, {result.data(),Nz,1});
+                    return result;
+                }
+            }
+
+            // rows of the result are independent, and each is summed in order
+            policy.for_each(0,Nr,execution::grain_for(Nc*Nz),[&](size_t lo, size_t hi)
+            {
+                for (size_t i = lo; i < hi; ++i)
+                {
+                    for (size_t k = 0; k < Nc; ++k)
+                    {
+                        auto const& element = matrix1[{i,k}];
+                        for (size_t j = 0; j < Nz; ++j)
+                        {
+                            result[{i,j}] += element * matrix2[{k,j}];
+                        }
+                    }
+                }
+            });
+            return result;
+        }
+
+        template <execution_policy Policy, typename Tp, size_t Nm>
+        constexpr auto determinant(Policy const& policy, Matrix<Tp,Nm,Nm> const& matrix) -> Tp
+        {
+            if constexpr (inverse<Tp,op_mul>::has() == logic::all) {
+                return LU<Tp,Nm>{policy,matrix}.determinant();
+            } else if constexpr (exact_division<Tp>::value) {
+                auto copy = matrix;
+                return bareiss(policy,copy.data(),Nm);
+            } else {
+                return determinant(matrix);
+            }
+        }
+
+        template <execution_policy Policy, typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() != logic::none)
+        constexpr auto invert(Policy const& policy, Matrix<Tp,Nm,Nm> const& matrix) -> Matrix<Tp,Nm,Nm>
+        {
+            if constexpr (inverse<Tp,op_mul>::has() == logic::all) {
+                return LU<Tp,Nm>{policy,matrix}.inverse(policy);
+            } else {
+                Matrix<Tp,Nm,Nm> source = matrix;
+                Matrix<Tp,Nm,Nm> result = identity<Matrix<Tp,Nm,Nm>,op_mul>::get();
+                gauss_jordan(policy,source.data(),Nm,result.data());
+                return result;
+            }
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        constexpr LU<Tp,Nm>::LU(Matrix<Tp,Nm,Nm> const& matrix)
+            : m_Factors{matrix}
+        {
+            auto const regular = lu_factor(m_Factors.data(),Nm,m_Pivots.data(),m_Reciprocals.data(),m_Odd);
+            m_Singular = !regular;
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <execution_policy Policy>
+        constexpr LU<Tp,Nm>::LU(Policy const& policy, Matrix<Tp,Nm,Nm> const& matrix)
+            : m_Factors{matrix}
+        {
+            auto const regular = lu_factor(policy,m_Factors.data(),Nm,m_Pivots.data(),m_Reciprocals.data(),m_Odd);
+            m_Singular = !regular;
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        constexpr auto LU<Tp,Nm>::determinant() const -> Tp
+        {
+            if (m_Singular) return identity<Tp,op_add>::get();
+
+            Tp result = identity<Tp,op_mul>::get();
+            for (size_t k = 0; k < Nm; ++k)
+            {
+                result *= m_Factors[{k,k}];
+            }
+            return m_Odd ? mpp::inverse<Tp,op_add>::get(result) : result;
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        constexpr auto LU<Tp,Nm>::inverse() const -> Matrix<Tp,Nm,Nm>
+        {
+            return solve(identity<Matrix<Tp,Nm,Nm>,op_mul>::get());
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <execution_policy Policy>
+        constexpr auto LU<Tp,Nm>::inverse(Policy const& policy) const -> Matrix<Tp,Nm,Nm>
+        {
+            return solve(policy,identity<Matrix<Tp,Nm,Nm>,op_mul>::get());
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <size_t Nk>
+        constexpr auto LU<Tp,Nm>::solve(Matrix<Tp,Nm,Nk> const& b) const -> Matrix<Tp,Nm,Nk>
+        {
+            return solve(execution::seq,b);
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <execution_policy Policy, size_t Nk>
+        constexpr auto LU<Tp,Nm>::solve(Policy const& policy, Matrix<Tp,Nm,Nk> const& b) const -> Matrix<Tp,Nm,Nk>
+        {
+            validate();
+            auto x = b;
+            lu_solve(policy,m_Factors.data(),Nm,m_Pivots.data(),m_Reciprocals.data(),x.data(),Nk);
+            return x;
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <typename Bv>
+            requires (Bv::size() == Nm) && requires (Bv b) { { b.data() } -> std::same_as<Tp*>; }
+        constexpr auto LU<Tp,Nm>::solve(Bv const& b) const -> Bv
+        {
+            auto x = b;
+            solve(std::span<Bv>{&x,1});
+            return x;
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <typename Bv>
+            requires (Bv::size() == Nm) && requires (Bv b) { { b.data() } -> std::same_as<Tp*>; }
+        constexpr void LU<Tp,Nm>::solve(std::span<Bv> batch) const
+        {
+            validate();
+            for (auto& b : batch)
+            {
+                lu_solve(m_Factors.data(),Nm,m_Pivots.data(),m_Reciprocals.data(),b.data(),1);
+            }
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        template <size_t Nk>
+        constexpr auto LU<Tp,Nm>::rsolve(Matrix<Tp,Nk,Nm> const& b) const -> Matrix<Tp,Nk,Nm>
+        {
+            validate();
+            auto x = b;
+            lu_rsolve(m_Factors.data(),Nm,m_Pivots.data(),m_Reciprocals.data(),x.data(),Nk);
+            return x;
+        }
+
+        template <typename Tp, size_t Nm>
+            requires (inverse<Tp,op_mul>::has() == logic::all)
+        constexpr void LU<Tp,Nm>::validate() const
+        {
+            if (m_Singular) throw std::domain_error("mpp::matrices::LU::solve");
+        }
+
     } // namespace matrices
 
 } // namespace mpp
@@ -316,29 +896,30 @@ namespace mpp
 {
 
     template <typename Tp, size_t Nr, size_t Nc>
-    Matrix<Tp,Nr,Nc>::Matrix()
-        : m_Elements(Nr*Nc)
+    constexpr Matrix<Tp,Nr,Nc>::Matrix()
+        : m_Elements{}
     {
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    Matrix<Tp,Nr,Nc>::Matrix(Tp const& value)
-        : m_Elements(Nr*Nc,value)
+    constexpr Matrix<Tp,Nr,Nc>::Matrix(Tp const& value)
+        : m_Elements{value}
     {
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    Matrix<Tp,Nr,Nc>::Matrix(std::span<Tp,Nr*Nc> const& span)
-        : m_Elements(span.begin(),span.end())
+    constexpr Matrix<Tp,Nr,Nc>::Matrix(std::span<Tp,Nr*Nc> const& span)
+        : m_Elements{}
     {
+        std::copy(span.begin(),span.end(),m_Elements.data());
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
     template <typename... Args>
         requires (std::conjunction<std::is_convertible<Args,Tp>...>::value)
             && (sizeof...(Args) == Nr*Nc)
-    Matrix<Tp,Nr,Nc>::Matrix(Args const&... args)
-        : m_Elements{static_cast<Tp>(args)...}
+    constexpr Matrix<Tp,Nr,Nc>::Matrix(Args const&... args)
+        : m_Elements{std::in_place,static_cast<Tp>(args)...}
     {
     }
 
@@ -346,31 +927,39 @@ namespace mpp
     template <typename... Args>
         requires (std::conjunction<std::is_same<Args,Tp>...>::value)
             && (sizeof...(Args) == Nr*Nc)
-    Matrix<Tp,Nr,Nc>::Matrix(Args&&... args)
-        : m_Elements{std::forward<Args>(args)...}
+    constexpr Matrix<Tp,Nr,Nc>::Matrix(Args&&... args)
+        : m_Elements{std::in_place,std::forward<Args>(args)...}
     {
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
     template <typename Tq>
         requires (std::is_convertible<Tq,Tp>::value)
-    Matrix<Tp,Nr,Nc>::Matrix(Matrix<Tq,Nr,Nc> const& other)
+    constexpr Matrix<Tp,Nr,Nc>::Matrix(Matrix<Tq,Nr,Nc> const& other)
+        : m_Elements{}
     {
-        m_Elements.reserve(Nr*Nc);
+        for (size_t i = 0; i < Nr*Nc; ++i)
+        {
+            m_Elements[i] = static_cast<Tp>(other[i]);
+        }
+    }
 
-        for (size_t i = 0; i < Nr; ++i)
+    template <typename Tp, size_t Nr, size_t Nc>
+    template <typename E>
+        requires expression_proxy<E> && same_shape<E,Matrix<Tp,Nr,Nc>>
+    constexpr Matrix<Tp,Nr,Nc>::Matrix(E const& expr)
+        : m_Elements{}
+    {
+        for (size_t i = 0; i < Nr*Nc; ++i)
         {
-            for (size_t j = 0; j < Nc; ++j)
-            {
-                m_Elements.push_back(static_cast<Tp>(other[{i,j}]));
-            }
+            m_Elements[i] = static_cast<Tp>(expr[i]);
         }
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
     template <typename Tq>
         requires (std::is_convertible<Tq,Tp>::value)
-    Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator=(Matrix<Tq,Nr,Nc> const& other)
+    constexpr Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator=(Matrix<Tq,Nr,Nc> const& other)
     {
         for (size_t i = 0; i < Nr; ++i)
         {
@@ -383,7 +972,24 @@ namespace mpp
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    void Matrix<Tp,Nr,Nc>::swap(Matrix<Tp,Nr,Nc>& other)
+    template <typename E>
+        requires expression_proxy<E> && same_shape<E,Matrix<Tp,Nr,Nc>>
+    constexpr Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator=(E const& expr)
+    {
+        if constexpr (holds_expression_view<E>::value)
+        {
+            return *this = expression_result_t<E>{expr};
+        }
+        // otherwise element-wise, so the expression may safely refer to this matrix
+        for (size_t i = 0; i < Nr*Nc; ++i)
+        {
+            m_Elements[i] = static_cast<Tp>(expr[i]);
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr void Matrix<Tp,Nr,Nc>::swap(Matrix<Tp,Nr,Nc>& other)
     {
         std::swap(m_Elements,other.m_Elements);
     }
@@ -396,7 +1002,7 @@ namespace mpp
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    void Matrix<Tp,Nr,Nc>::assign(Tp const& value)
+    constexpr void Matrix<Tp,Nr,Nc>::assign(Tp const& value)
     {
         for (size_t i = 0; i < Nr; ++i)
         {
@@ -411,39 +1017,68 @@ namespace mpp
     template <typename... Args>
         requires (std::conjunction<std::is_convertible<Args,Tp>...>::value)
             && (sizeof...(Args) == Nr*Nc)
-    void Matrix<Tp,Nr,Nc>::assign(Args&&... args)
+    constexpr void Matrix<Tp,Nr,Nc>::assign(Args&&... args)
     {
-        m_Elements = {std::forward<Args>(args)...};
+        m_Elements = Storage<Tp,Nr*Nc>{std::in_place,static_cast<Tp>(std::forward<Args>(args))...};
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    auto Matrix<Tp,Nr,Nc>::operator[](std::array<size_t,2> const& indices) const -> Tp const&
+    constexpr auto Matrix<Tp,Nr,Nc>::at(size_t index) const -> Tp const&
+    {
+        if (index >= Nr*Nc) throw std::out_of_range("mpp::Matrix::at");
+        return m_Elements[index];
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto Matrix<Tp,Nr,Nc>::at(size_t index) -> Tp&
+    {
+        if (index >= Nr*Nc) throw std::out_of_range("mpp::Matrix::at");
+        return m_Elements[index];
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto Matrix<Tp,Nr,Nc>::operator[](std::array<size_t,2> const& indices) const -> Tp const&
     {
         return m_Elements[index(indices)];
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    auto Matrix<Tp,Nr,Nc>::operator[](std::array<size_t,2> const& indices) -> Tp&
+    constexpr auto Matrix<Tp,Nr,Nc>::operator[](std::array<size_t,2> const& indices) -> Tp&
     {
         return m_Elements[index(indices)];
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    auto Matrix<Tp,Nr,Nc>::at(std::array<size_t,2> const& indices) const -> Tp const&
+    constexpr auto Matrix<Tp,Nr,Nc>::at(std::array<size_t,2> const& indices) const -> Tp const&
     {
-        return m_Elements.at(index(indices));
+        if (indices[0] >= Nr || indices[1] >= Nc) throw std::out_of_range("mpp::Matrix::at");
+        return m_Elements[index(indices)];
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    auto Matrix<Tp,Nr,Nc>::at(std::array<size_t,2> const& indices) -> Tp&
+    constexpr auto Matrix<Tp,Nr,Nc>::at(std::array<size_t,2> const& indices) -> Tp&
     {
-        return m_Elements.at(index(indices));
+        if (indices[0] >= Nr || indices[1] >= Nc) throw std::out_of_range("mpp::Matrix::at");
+        return m_Elements[index(indices)];
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    template <typename Tq>
-    Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator+=(Matrix<Tq,Nr,Nc> const& other)
+    template <typename E>
+        requires same_shape<E,Matrix<Tp,Nr,Nc>>
+    constexpr Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator+=(E const& other)
     {
+        if constexpr (holds_expression_view<E>::value)
+        {
+            return *this += expression_result_t<E>{other};
+        }
+        if constexpr (std::is_same<E,Matrix<Tp,Nr,Nc>>::value && simd::supported<Tp> && Nr*Nc >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::add(data(),other.data(),Nr*Nc);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nr*Nc; ++i)
         {
             m_Elements[i] += other[i];
@@ -452,9 +1087,22 @@ namespace mpp
     }
 
     template <typename Tp, size_t Nr, size_t Nc>
-    template <typename Tq>
-    Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator-=(Matrix<Tq,Nr,Nc> const& other)
+    template <typename E>
+        requires same_shape<E,Matrix<Tp,Nr,Nc>>
+    constexpr Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator-=(E const& other)
     {
+        if constexpr (holds_expression_view<E>::value)
+        {
+            return *this -= expression_result_t<E>{other};
+        }
+        if constexpr (std::is_same<E,Matrix<Tp,Nr,Nc>>::value && simd::supported<Tp> && Nr*Nc >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::sub(data(),other.data(),Nr*Nc);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nr*Nc; ++i)
         {
             m_Elements[i] -= other[i];
@@ -464,8 +1112,17 @@ namespace mpp
 
     template <typename Tp, size_t Nr, size_t Nc>
     template <typename Tq>
-    Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator*=(Tq const& scalar)
+        requires (!expression<Tq>)
+    constexpr Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator*=(Tq const& scalar)
     {
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp> && Nr*Nc >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::mul(data(),scalar,Nr*Nc);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nr*Nc; ++i)
         {
             m_Elements[i] *= scalar;
@@ -475,8 +1132,17 @@ namespace mpp
 
     template <typename Tp, size_t Nr, size_t Nc>
     template <typename Tq>
-    Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator/=(Tq const& scalar)
+        requires (!expression<Tq>)
+    constexpr Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator/=(Tq const& scalar)
     {
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp> && Nr*Nc >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::div(data(),scalar,Nr*Nc);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nr*Nc; ++i)
         {
             m_Elements[i] /= scalar;
@@ -486,7 +1152,8 @@ namespace mpp
 
     template <typename Tp, size_t Nr, size_t Nc>
     template <typename Tq>
-    Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator%=(Tq const& scalar)
+        requires (!expression<Tq>)
+    constexpr Matrix<Tp,Nr,Nc>& Matrix<Tp,Nr,Nc>::operator%=(Tq const& scalar)
     {
         for (size_t i = 0; i < Nr*Nc; ++i)
         {
@@ -506,7 +1173,7 @@ namespace mpp
 
     template <typename Tp1, size_t Nr1, size_t Nc1, typename Tp2, size_t Nr2, size_t Nc2>
         requires requires (Tp1 a, Tp2 b) { a != b; }
-    bool operator==(Matrix<Tp1,Nr1,Nc1> const& matrix1, Matrix<Tp2,Nr2,Nc2> const& matrix2)
+    constexpr bool operator==(Matrix<Tp1,Nr1,Nc1> const& matrix1, Matrix<Tp2,Nr2,Nc2> const& matrix2)
     {
         if constexpr (Nr1 != Nr2 || Nc1 != Nc2) {
             return false;
@@ -518,54 +1185,34 @@ namespace mpp
         return true;
     }
 
-    template <typename Tp, size_t Nr, size_t Nc>
-        requires (identity<Matrix<Tp,Nr,Nc>,op_add>::has() != logic::none)
-    auto operator+(Matrix<Tp,Nr,Nc> const& matrix)
-    {
-        Matrix<Tp,Nr,Nc> result = identity<Matrix<Tp,Nr,Nc>,op_add>::get();
-        return result += matrix;
-    }
-
-    template <typename Tp, size_t Nr, size_t Nc>
-        requires (identity<Matrix<Tp,Nr,Nc>,op_add>::has() != logic::none)
-    auto operator-(Matrix<Tp,Nr,Nc> const& matrix)
-    {
-        Matrix<Tp,Nr,Nc> result = identity<Matrix<Tp,Nr,Nc>,op_add>::get();
-        return result -= matrix;
-    }
-
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-        requires requires (Tp a, Tq b) { a + b; }
-    auto operator+(Matrix<Tp,Nr,Nc> const& matrix1, Matrix<Tq,Nr,Nc> const& matrix2)
-    {
-        using Tr = op_add::result<Tp,Tq>::type;
-        Matrix<Tr,Nr,Nc> result = matrix1;
-        return result += matrix2;
-    }
-
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-        requires requires (Tp a, Tq b) { a - b; }
-    auto operator-(Matrix<Tp,Nr,Nc> const& matrix1, Matrix<Tq,Nr,Nc> const& matrix2)
-    {
-        using Tr = op_add::result<Tp,Tq>::type;
-        Matrix<Tr,Nr,Nc> result = matrix1;
-        return result -= matrix2;
-    }
-
     template <typename Tp, typename Tq, size_t Nr, size_t Nc, size_t Nz>
         requires requires (Tp a, Tq b) { a * b; }
-    auto operator*(Matrix<Tp,Nr,Nc> const& matrix1, Matrix<Tq,Nc,Nz> const& matrix2)
+    constexpr auto operator*(Matrix<Tp,Nr,Nc> const& matrix1, Matrix<Tq,Nc,Nz> const& matrix2)
     {
         using Tr = op_mul::result<Tp,Tq>::type;
         Matrix<Tr,Nr,Nz> result {identity<Tr,op_add>::get()};
 
+        if constexpr (std::is_same<Tp,Tq>::value && std::is_same<Tr,Tp>::value
+            && std::is_arithmetic<Tp>::value && !std::is_same<Tp,bool>::value
+            && Nr*Nc*Nz >= gemm::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                gemm::multiply<Tp>(Nr,Nz,Nc,
+                    {matrix1.data(),Nc,1}, {matrix2.data(),Nz,1}, {result.data(),Nz,1});
+                return result;
+            }
+        }
+
+        // row-wise, so that the inner loop runs along rows of both operands
         for (size_t i = 0; i < Nr; ++i)
         {
-            for (size_t j = 0; j < Nz; ++j)
+            for (size_t k = 0; k < Nc; ++k)
             {
-                for (size_t k = 0; k < Nc; ++k)
+                auto const& element = matrix1[{i,k}];
+                for (size_t j = 0; j < Nz; ++j)
                 {
-                    result[{i,j}] += matrix1[{i,k}] * matrix2[{k,j}];
+                    result[{i,j}] += element * matrix2[{k,j}];
                 }
             }
         }
@@ -573,89 +1220,29 @@ namespace mpp
     }
 
     template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-        requires requires (Tp a, Tq b) { a * b; }
-    auto operator*(Matrix<Tp,Nr,Nc> const& matrix, Tq const& scalar)
+        requires (inverse<Matrix<Tq,Nc,Nc>,op_mul>::has() != logic::none)
+    constexpr auto operator/(Matrix<Tp,Nr,Nc> const& matrix1, Matrix<Tq,Nc,Nc> const& matrix2)
     {
-        using Tr = op_mul::result<Tp,Tq>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nr*Nc);
-
-        for (size_t i = 0; i < Nr*Nc; ++i)
+        if constexpr (std::is_same<Tp,Tq>::value && inverse<Tq,op_mul>::has() == logic::all)
         {
-            auto element = matrix[i] * scalar;
-            elements.push_back(std::move(element));
+            // solve against the factors, rather than forming the inverse
+            return matrices::LU<Tq,Nc>{matrix2}.rsolve(matrix1);
         }
-        std::span<Tr,Nr*Nc> span {elements.begin(),elements.end()};
-        return Matrix<Tr,Nr,Nc>{span};
-    }
-
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-        requires requires (Tp a, Tq b) { b * a; }
-    auto operator*(Tq const& scalar, Matrix<Tp,Nr,Nc> const& matrix)
-    {
-        using Tr = op_mul::result<Tq,Tp>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nr*Nc);
-
-        for (size_t i = 0; i < Nr*Nc; ++i)
+        else
         {
-            auto element = scalar * matrix[i];
-            elements.push_back(std::move(element));
+            using inverse = inverse<Matrix<Tq,Nc,Nc>,op_mul>;
+            return matrix1 * inverse::get(matrix2);
         }
-        std::span<Tr,Nr*Nc> span {elements.begin(),elements.end()};
-        return Matrix<Tr,Nr,Nc>{span};
-    }
-
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-        requires (inverse<Matrix<Tq,Nc,Nc>,op_mul>::has() != logic::none)
-    auto operator/(Matrix<Tp,Nr,Nc> const& matrix1, Matrix<Tq,Nc,Nc> const& matrix2)
-    {
-        using inverse = inverse<Matrix<Tq,Nc,Nc>,op_mul>;
-        return matrix1 * inverse::get(matrix2);
     }
 
     template <typename Tp, typename Tq, size_t Nm>
         requires (inverse<Matrix<Tq,Nm,Nm>,op_mul>::has() != logic::none)
-    auto operator/(Tp const& object, Matrix<Tq,Nm,Nm> const& matrix)
+    constexpr auto operator/(Tp const& object, Matrix<Tq,Nm,Nm> const& matrix)
     {
         using inverse = inverse<Matrix<Tq,Nm,Nm>,op_mul>;
         return object * inverse::get(matrix);
     }
 
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-        requires requires (Tp a, Tq b) { a / b; }
-    auto operator/(Matrix<Tp,Nr,Nc> const& matrix, Tq const& scalar)
-    {
-        using Tr = op_mul::result<Tp,Tq>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nr*Nc);
-
-        for (size_t i = 0; i < Nr*Nc; ++i)
-        {
-            auto element = matrix[i] / scalar;
-            elements.push_back(std::move(element));
-        }
-        std::span<Tr,Nr*Nc> span {elements.begin(),elements.end()};
-        return Matrix<Tr,Nr,Nc>{span};
-    }
-
-    template <typename Tp, typename Tq, size_t Nr, size_t Nc>
-        requires (modulo<Tp,Tq>::has() != logic::none)
-    auto operator%(Matrix<Tp,Nr,Nc> const& matrix, Tq const& scalar)
-    {
-        using Tr = op_mul::result<Tp,Tq>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nr*Nc);
-
-        for (size_t i = 0; i < Nr*Nc; ++i)
-        {
-            auto element = modulo<Tp,Tq>::get(matrix[i],scalar);
-            elements.push_back(std::move(element));
-        }
-        std::span<Tr,Nr*Nc> span {elements.begin(),elements.end()};
-        return Matrix<Tr,Nr,Nc>{span};
-    }
-
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -666,7 +1253,7 @@ namespace std
 {
 
     template <typename Tp, size_t Nr, size_t Nc>
-    void swap(mpp::Matrix<Tp,Nr,Nc>& matrix1, mpp::Matrix<Tp,Nr,Nc>& matrix2)
+    constexpr void swap(mpp::Matrix<Tp,Nr,Nc>& matrix1, mpp::Matrix<Tp,Nr,Nc>& matrix2)
     {
         return matrix1.swap(matrix2);
     }
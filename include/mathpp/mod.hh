@@ -7,6 +7,17 @@
 
 #include <stdexcept>
 #include <compare>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 /* ************************************************************************** */
 // Definitions
@@ -16,13 +27,12 @@ namespace mpp
 {
 
     template <typename Tp>
-    class Mod
+    class Mod final
     {
     public:
         explicit Mod(Tp const&);
         explicit Mod(Tp const&, Tp const&);
         explicit Mod(Tp const&, Tp&&);
-        virtual ~Mod() = default;
 
         template <typename Tq>
         Mod(Mod<Tq> const&);
@@ -41,30 +51,30 @@ namespace mpp
         Mod(Mod<Tp>&&) = default;
         Mod<Tp>& operator=(Mod<Tp>&&);
 
-    protected:
-        virtual void validate();
+    private:
+        void validate();
 
     public:
-        virtual auto modulus() const -> Tp const& { return m_Modulus; }
-        virtual auto value() const -> Tp const& { return m_Value; }
+        auto modulus() const -> Tp const& { return m_Modulus; }
+        auto value() const -> Tp const& { return m_Value; }
 
-        virtual void swap(Mod<Tp>&);
+        void swap(Mod<Tp>&);
 
         template <typename Tq>
         Mod<Tp>& operator<<=(Tq const&);
         template <typename Tq>
         Mod<Tp>& operator>>=(Tq const&);
 
-        virtual Mod<Tp>& operator++();
-        virtual Mod<Tp>& operator--();
-        virtual Mod<Tp> operator++(int);
-        virtual Mod<Tp> operator--(int);
+        Mod<Tp>& operator++();
+        Mod<Tp>& operator--();
+        Mod<Tp> operator++(int);
+        Mod<Tp> operator--(int);
 
-        virtual Mod<Tp>& operator+=(Tp const&);
-        virtual Mod<Tp>& operator-=(Tp const&);
-        virtual Mod<Tp>& operator*=(Tp const&);
-        virtual Mod<Tp>& operator/=(Tp const&);
-        virtual Mod<Tp>& operator%=(Tp const&);
+        Mod<Tp>& operator+=(Tp const&);
+        Mod<Tp>& operator-=(Tp const&);
+        Mod<Tp>& operator*=(Tp const&);
+        Mod<Tp>& operator/=(Tp const&);
+        Mod<Tp>& operator%=(Tp const&);
 
         template <typename Tq>
         Mod<Tp>& operator+=(Mod<Tq> const&);
@@ -77,11 +87,234 @@ namespace mpp
         template <typename Tq>
         Mod<Tp>& operator%=(Mod<Tq> const&);
 
-    protected:
+    private:
         Tp const m_Modulus{};
         Tp m_Value{};
     };
 
+    namespace modular
+    {
+
+        // a type of the same signedness holding the full product of two `Tp`
+        template <std::integral Tp>
+        struct wide
+        {
+            using type = std::conditional_t<std::is_signed<Tp>::value,
+                std::conditional_t<(sizeof(Tp) <= 2), int32_t,
+                std::conditional_t<(sizeof(Tp) == 4), int64_t, __int128>>,
+                std::conditional_t<(sizeof(Tp) <= 2), uint32_t,
+                std::conditional_t<(sizeof(Tp) == 4), uint64_t, unsigned __int128>>>;
+        };
+
+        // `a * b mod m`, through a double-width product for integral types
+        template <typename Tp>
+        constexpr auto multiply(Tp const& a, Tp const& b, Tp const& m) -> Tp;
+
+        /*
+         * The inverse of `a` modulo `m`, or nothing when they share a factor.
+         * Coefficients are tracked by magnitude, so no intermediate leaves the
+         * range of `Tp` and unsigned types invert correctly.
+         */
+        template <std::unsigned_integral Tp>
+        constexpr auto invert(Tp const& a, Tp const& m) -> std::optional<Tp>;
+
+        /*
+         * Barrett's reduction by `m`, for `m` up to `2^(bits-1)`. The shift is
+         * the bit length `k` of `m - 1` and the reciprocal `2^(bits+k-1) / m`;
+         * `reduce` then takes `t mod m` for any `t < m^2`.
+         */
+        template <std::unsigned_integral Tp>
+        constexpr auto barrett_shift(Tp const& m) -> int;
+
+        template <std::unsigned_integral Tp>
+        constexpr auto barrett_reciprocal(Tp const& m) -> Tp;
+
+        template <std::unsigned_integral Tp>
+        constexpr auto barrett_reduce(typename wide<Tp>::type const& t, Tp const& m, Tp const& reciprocal, int shift) -> Tp;
+
+    } // namespace modular
+
+    /*
+     * Residues modulo a fixed odd modulus, held in Montgomery form `aR mod m`
+     * with `R = 2^bits`. Products are reduced by multiplying and shifting, so
+     * chains of arithmetic never divide. Values enter and leave the form by
+     * construction and by `value()`, which do. Operands of a binary operation
+     * must share a modulus.
+     */
+    template <std::unsigned_integral Tp>
+    class Montgomery final
+    {
+        using Wide = typename modular::wide<Tp>::type;
+        constexpr static int bits = std::numeric_limits<Tp>::digits;
+
+    public:
+        explicit Montgomery(Tp const&);
+        explicit Montgomery(Tp const&, Tp const&);
+        explicit Montgomery(Mod<Tp> const&);
+
+        explicit operator Mod<Tp>() const;
+
+    public:
+        auto modulus() const -> Tp const& { return m_Modulus; }
+        auto value() const -> Tp { return reduce(m_Value); }
+        auto form() const -> Tp const& { return m_Value; }
+
+        void swap(Montgomery<Tp>&);
+
+        Montgomery<Tp>& operator+=(Montgomery<Tp> const&);
+        Montgomery<Tp>& operator-=(Montgomery<Tp> const&);
+        Montgomery<Tp>& operator*=(Montgomery<Tp> const&);
+
+    private:
+        // REDC: `t / R mod m` for any `t < mR`
+        auto reduce(Wide const&) const -> Tp;
+
+    private:
+        Tp m_Modulus{};
+        Tp m_Inverse{}; // m^-1 mod R
+        Tp m_Value{};
+    };
+
+    /*
+     * Residues modulo any modulus up to `2^(bits-1)`, reduced by Barrett's
+     * method. The reciprocal `2^(bits+k-1) / m`, for the `k` bits of `m - 1`,
+     * is found once; products are then reduced by two multiplications and at
+     * most two subtractions. Values are held as they are, so they enter and
+     * leave freely. Operands of a binary operation must share a modulus.
+     */
+    template <std::unsigned_integral Tp>
+    class Barrett final
+    {
+        using Wide = typename modular::wide<Tp>::type;
+        constexpr static int bits = std::numeric_limits<Tp>::digits;
+
+    public:
+        explicit Barrett(Tp const&);
+        explicit Barrett(Tp const&, Tp const&);
+        explicit Barrett(Mod<Tp> const&);
+
+        explicit operator Mod<Tp>() const;
+
+    public:
+        auto modulus() const -> Tp const& { return m_Modulus; }
+        auto value() const -> Tp const& { return m_Value; }
+
+        void swap(Barrett<Tp>&);
+
+        Barrett<Tp>& operator+=(Barrett<Tp> const&);
+        Barrett<Tp>& operator-=(Barrett<Tp> const&);
+        Barrett<Tp>& operator*=(Barrett<Tp> const&);
+
+    private:
+        Tp m_Modulus{};
+        Tp m_Reciprocal{}; // 2^(bits+k-1) / m
+        int m_Shift{}; // k, so that 2^(k-1) < m <= 2^k
+        Tp m_Value{};
+    };
+
+    /*
+     * Residues modulo a constant `M`, held as one `Tp`. The Barrett constants
+     * are found at compile time, so arrays of residues are dense and products
+     * never divide. Without a modulus to carry, the identities need no
+     * argument and residues serve as coefficients of `Poly`.
+     */
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    class StaticMod final
+    {
+        using Wide = typename modular::wide<Tp>::type;
+        constexpr static int shift = modular::barrett_shift(M);
+        constexpr static Tp reciprocal = modular::barrett_reciprocal(M);
+
+    public:
+        constexpr StaticMod() = default;
+        constexpr explicit StaticMod(Tp const&);
+        constexpr explicit StaticMod(Mod<Tp> const&);
+
+        explicit operator Mod<Tp>() const;
+
+    public:
+        constexpr static auto modulus() -> Tp { return M; }
+        constexpr auto value() const -> Tp const& { return m_Value; }
+
+        constexpr StaticMod& operator++();
+        constexpr StaticMod& operator--();
+
+        constexpr StaticMod& operator+=(StaticMod const&);
+        constexpr StaticMod& operator-=(StaticMod const&);
+        constexpr StaticMod& operator*=(StaticMod const&);
+        constexpr StaticMod& operator/=(StaticMod const&);
+
+    private:
+        Tp m_Value{};
+    };
+
+    namespace modular
+    {
+
+        /*
+         * Powers of any type with a multiplicative identity, by left-to-right
+         * sliding windows over precomputed odd powers. Residues of `Mod` with
+         * an unsigned type are raised in Montgomery form for odd moduli and by
+         * Barrett reduction otherwise.
+         */
+        template <typename Tm, std::unsigned_integral Te>
+        auto pow(Tm const& base, Te const& exponent) -> Tm;
+
+        template <typename Tp, std::unsigned_integral Te>
+        auto pow(Mod<Tp> const& base, Te const& exponent) -> Mod<Tp>;
+
+        /*
+         * The product of `bases[i]^exponents[i]`, by Straus' method: one chain
+         * of squarings is shared by every base, each multiplying in a window of
+         * its exponent from a table of its small powers. Bases must share a
+         * modulus.
+         */
+        template <typename Tm, std::unsigned_integral Te>
+        auto multipow(std::span<Tm const> bases, std::span<Te const> exponents) -> Tm;
+
+        template <typename Tp, std::unsigned_integral Te>
+        auto multipow(std::span<Mod<Tp> const> bases, std::span<Te const> exponents) -> Mod<Tp>;
+
+        // the sliding window width that minimises products for an exponent of `n` bits
+        constexpr auto window(int n) -> int;
+
+        /*
+         * Inverts every element of `values` in place by Montgomery's trick: the
+         * running products are inverted once, then unwound in `3(n-1)` products.
+         * Elements without an inverse are left as they are and their indices
+         * returned; finding them costs one more inversion per halving of the
+         * batch that contains one.
+         */
+        template <typename Tm>
+        auto invert(std::span<Tm> values) -> std::vector<size_t>;
+
+        /*
+         * Powers of one fixed base by Lim and Lee's comb. An exponent of up to
+         * `bits` bits is split into `teeth` rows of `a = bits / teeth` columns,
+         * and the `2^teeth` products of the bases `base^(2^(ja))` are found
+         * once. Each power then costs at most `a` squarings and `a` products.
+         */
+        template <typename Tm>
+        class Comb final
+        {
+        public:
+            explicit Comb(Tm const& base, int bits = 64, int teeth = 6);
+
+        public:
+            auto bits() const -> int { return m_Teeth * m_Spacing; }
+
+            template <std::unsigned_integral Te>
+            auto pow(Te const& exponent) const -> Tm;
+
+        private:
+            int m_Teeth{};
+            int m_Spacing{};
+            std::vector<Tm> m_Table{};
+        };
+
+    } // namespace modular
+
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -146,8 +379,16 @@ namespace mpp
         }
         constexpr static Mod<Tp> get(Mod<Tp> const& e)
         {
-            auto [x,y] = gcd_extended(e.value(),e.modulus());
-            return Mod<Tp>{e.modulus(),x};
+            if constexpr (std::unsigned_integral<Tp>)
+            {
+                // Bezout coefficients are negative half the time, so they cannot wrap
+                return Mod<Tp>{e.modulus(),modular::invert(e.value(),e.modulus()).value_or(0)};
+            }
+            else
+            {
+                auto [x,y] = gcd_extended(e.value(),e.modulus());
+                return Mod<Tp>{e.modulus(),x};
+            }
         }
         constexpr static Mod<Tp>& make(Mod<Tp>& e)
         {
@@ -178,6 +419,201 @@ namespace mpp
         }
     };
 
+    // identity
+
+    template <typename Tp, typename Op>
+    struct identity<Montgomery<Tp>,Op>
+    {
+        constexpr static tristate has()
+        {
+            return identity<Tp,Op>::has();
+        }
+        static Montgomery<Tp> get(Tp const& mod)
+        {
+            return Montgomery<Tp>{mod,identity<Tp,Op>::get()};
+        }
+        static Montgomery<Tp>& make(Montgomery<Tp>& e)
+        {
+            return e = get(e.modulus());
+        }
+    };
+
+    // inverse
+
+    template <typename Tp>
+    struct inverse<Montgomery<Tp>,op_add>
+    {
+        constexpr static tristate has()
+        {
+            return logic::all;
+        }
+        constexpr static bool can(Montgomery<Tp> const&)
+        {
+            return true;
+        }
+        static Montgomery<Tp> get(Montgomery<Tp> const& e)
+        {
+            return -e;
+        }
+        static Montgomery<Tp>& make(Montgomery<Tp>& e)
+        {
+            return e = get(e);
+        }
+    };
+
+    template <typename Tp>
+    struct inverse<Montgomery<Tp>,op_mul>
+    {
+        constexpr static tristate has()
+        {
+            return logic::some;
+        }
+        static bool can(Montgomery<Tp> const& e)
+        {
+            return modular::invert(e.form(),e.modulus()).has_value();
+        }
+        static Montgomery<Tp> get(Montgomery<Tp> const& e)
+        {
+            auto const x = modular::invert(e.value(),e.modulus());
+            if (!x) throw std::domain_error("mpp::inverse<Montgomery,op_mul>::get");
+            return Montgomery<Tp>{e.modulus(),*x};
+        }
+        static Montgomery<Tp>& make(Montgomery<Tp>& e)
+        {
+            return e = get(e);
+        }
+    };
+
+    // identity
+
+    template <typename Tp, typename Op>
+    struct identity<Barrett<Tp>,Op>
+    {
+        constexpr static tristate has()
+        {
+            return identity<Tp,Op>::has();
+        }
+        static Barrett<Tp> get(Tp const& mod)
+        {
+            return Barrett<Tp>{mod,identity<Tp,Op>::get()};
+        }
+        static Barrett<Tp>& make(Barrett<Tp>& e)
+        {
+            return e = get(e.modulus());
+        }
+    };
+
+    // inverse
+
+    template <typename Tp>
+    struct inverse<Barrett<Tp>,op_add>
+    {
+        constexpr static tristate has()
+        {
+            return logic::all;
+        }
+        constexpr static bool can(Barrett<Tp> const&)
+        {
+            return true;
+        }
+        static Barrett<Tp> get(Barrett<Tp> const& e)
+        {
+            return -e;
+        }
+        static Barrett<Tp>& make(Barrett<Tp>& e)
+        {
+            return e = get(e);
+        }
+    };
+
+    template <typename Tp>
+    struct inverse<Barrett<Tp>,op_mul>
+    {
+        constexpr static tristate has()
+        {
+            return logic::some;
+        }
+        static bool can(Barrett<Tp> const& e)
+        {
+            return modular::invert(e.value(),e.modulus()).has_value();
+        }
+        static Barrett<Tp> get(Barrett<Tp> const& e)
+        {
+            auto const x = modular::invert(e.value(),e.modulus());
+            if (!x) throw std::domain_error("mpp::inverse<Barrett,op_mul>::get");
+            return Barrett<Tp>{e.modulus(),*x};
+        }
+        static Barrett<Tp>& make(Barrett<Tp>& e)
+        {
+            return e = get(e);
+        }
+    };
+
+    // identity
+
+    template <typename Tp, Tp M, typename Op>
+    struct identity<StaticMod<Tp,M>,Op>
+    {
+        constexpr static tristate has()
+        {
+            return identity<Tp,Op>::has();
+        }
+        constexpr static StaticMod<Tp,M> get()
+        {
+            return StaticMod<Tp,M>{identity<Tp,Op>::get()};
+        }
+        constexpr static StaticMod<Tp,M>& make(StaticMod<Tp,M>& e)
+        {
+            return e = get();
+        }
+    };
+
+    // inverse
+
+    template <typename Tp, Tp M>
+    struct inverse<StaticMod<Tp,M>,op_add>
+    {
+        constexpr static tristate has()
+        {
+            return logic::all;
+        }
+        constexpr static bool can(StaticMod<Tp,M> const&)
+        {
+            return true;
+        }
+        constexpr static StaticMod<Tp,M> get(StaticMod<Tp,M> const& e)
+        {
+            return -e;
+        }
+        constexpr static StaticMod<Tp,M>& make(StaticMod<Tp,M>& e)
+        {
+            return e = get(e);
+        }
+    };
+
+    template <typename Tp, Tp M>
+    struct inverse<StaticMod<Tp,M>,op_mul>
+    {
+        constexpr static tristate has()
+        {
+            return logic::some;
+        }
+        constexpr static bool can(StaticMod<Tp,M> const& e)
+        {
+            return modular::invert(e.value(),M).has_value();
+        }
+        constexpr static StaticMod<Tp,M> get(StaticMod<Tp,M> const& e)
+        {
+            auto const x = modular::invert(e.value(),M);
+            if (!x) throw std::domain_error("mpp::inverse<StaticMod,op_mul>::get");
+            return StaticMod<Tp,M>{*x};
+        }
+        constexpr static StaticMod<Tp,M>& make(StaticMod<Tp,M>& e)
+        {
+            return e = get(e);
+        }
+    };
+
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -353,8 +789,7 @@ namespace mpp
     template <typename Tp>
     Mod<Tp>& Mod<Tp>::operator*=(Tp const& num)
     {
-        m_Value *= num;
-        validate();
+        m_Value = modular::multiply(m_Value,num,m_Modulus);
         return *this;
     }
 
@@ -396,8 +831,7 @@ namespace mpp
     template <typename Tq>
     Mod<Tp>& Mod<Tp>::operator*=(Mod<Tq> const& other)
     {
-        m_Value *= static_cast<Tp>(other.value());
-        validate();
+        m_Value = modular::multiply(m_Value,static_cast<Tp>(other.value()),m_Modulus);
         return *this;
     }
 
@@ -419,6 +853,581 @@ namespace mpp
         return *this;
     }
 
+    namespace modular
+    {
+
+        template <std::unsigned_integral Tp>
+        constexpr auto invert(Tp const& a, Tp const& m)
+            -> std::optional<Tp>
+        {
+            // remainders r0, r1 are +-s0 a, +-s1 a (mod m) with alternating signs
+            Tp r0 = m, r1 = a % m;
+            Tp s0 = 0, s1 = 1;
+            bool negative = true;
+            while (r1 != 0)
+            {
+                Tp const q = r0 / r1;
+                r0 = Tp(r0 - q * r1);
+                s0 = Tp(s0 + q * s1);
+                std::swap(r0,r1);
+                std::swap(s0,s1);
+                negative = !negative;
+            }
+            if (r0 != 1) return std::nullopt;
+            return Tp((negative ? Tp(m - s0) : s0) % m);
+        }
+
+        template <typename Tp>
+        constexpr auto multiply(Tp const& a, Tp const& b, Tp const& m)
+            -> Tp
+        {
+            if constexpr (std::integral<Tp>)
+            {
+                using Wide = typename wide<Tp>::type;
+                auto result = Wide(Wide(a) * Wide(b) % Wide(m));
+                if constexpr (std::is_signed<Tp>::value)
+                {
+                    if (result < 0) result += m;
+                }
+                return Tp(result);
+            }
+            else
+            {
+                return modulo<Tp,Tp>::get(a * b,m);
+            }
+        }
+
+        template <std::unsigned_integral Tp>
+        constexpr auto barrett_shift(Tp const& m)
+            -> int
+        {
+            return std::max(int(std::bit_width(Tp(m-1))),1);
+        }
+
+        template <std::unsigned_integral Tp>
+        constexpr auto barrett_reciprocal(Tp const& m)
+            -> Tp
+        {
+            using Wide = typename wide<Tp>::type;
+            constexpr int bits = std::numeric_limits<Tp>::digits;
+            return Tp((Wide(1) << (bits+barrett_shift(m)-1)) / m);
+        }
+
+        template <std::unsigned_integral Tp>
+        constexpr auto barrett_reduce(typename wide<Tp>::type const& t, Tp const& m, Tp const& reciprocal, int shift)
+            -> Tp
+        {
+            using Wide = typename wide<Tp>::type;
+            constexpr int bits = std::numeric_limits<Tp>::digits;
+
+            // the estimate falls short of the quotient by at most two, so the
+            // remainder reaches 3m-1 and is corrected before narrowing
+            Wide const q = (Wide(Tp(t >> (shift-1))) * reciprocal) >> bits;
+            Wide r = t - q * m;
+            if (r >= m) r -= m;
+            if (r >= m) r -= m;
+            return Tp(r);
+        }
+
+    } // namespace modular
+
+    template <std::unsigned_integral Tp>
+    Montgomery<Tp>::Montgomery(Tp const& mod)
+        : Montgomery{mod,0}
+    {
+    }
+
+    template <std::unsigned_integral Tp>
+    Montgomery<Tp>::Montgomery(Tp const& mod, Tp const& val)
+        : m_Modulus{mod}
+    {
+        if (mod % 2 == 0) throw std::invalid_argument("mpp::Montgomery");
+
+        // Newton's iteration doubles the bits of m^-1 mod R, from the three of m
+        m_Inverse = mod;
+        while (Tp(Wide(mod) * m_Inverse) != 1)
+        {
+            m_Inverse = Tp(Wide(m_Inverse) * Tp(2 - Tp(Wide(mod) * m_Inverse)));
+        }
+        m_Value = Tp((Wide(val % mod) << bits) % mod);
+    }
+
+    template <std::unsigned_integral Tp>
+    Montgomery<Tp>::Montgomery(Mod<Tp> const& other)
+        : Montgomery{other.modulus(),other.value()}
+    {
+    }
+
+    template <std::unsigned_integral Tp>
+    Montgomery<Tp>::operator Mod<Tp>() const
+    {
+        return Mod<Tp>{m_Modulus,value()};
+    }
+
+    template <std::unsigned_integral Tp>
+    auto Montgomery<Tp>::reduce(Wide const& t) const
+        -> Tp
+    {
+        // the low halves of t and qm agree, so only the high halves subtract
+        Tp const q = Tp(Wide(Tp(t)) * m_Inverse);
+        Tp const hi = Tp(t >> bits);
+        Tp const lo = Tp((Wide(q) * m_Modulus) >> bits);
+        return (hi < lo) ? Tp(hi - lo + m_Modulus) : Tp(hi - lo);
+    }
+
+    template <std::unsigned_integral Tp>
+    void Montgomery<Tp>::swap(Montgomery<Tp>& other)
+    {
+        std::swap(m_Modulus,other.m_Modulus);
+        std::swap(m_Inverse,other.m_Inverse);
+        std::swap(m_Value,other.m_Value);
+    }
+
+    template <std::unsigned_integral Tp>
+    Montgomery<Tp>& Montgomery<Tp>::operator+=(Montgomery<Tp> const& other)
+    {
+        Tp const sum = Tp(m_Value + other.m_Value);
+        m_Value = (sum < m_Value || sum >= m_Modulus) ? Tp(sum - m_Modulus) : sum;
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp>
+    Montgomery<Tp>& Montgomery<Tp>::operator-=(Montgomery<Tp> const& other)
+    {
+        Tp const difference = Tp(m_Value - other.m_Value);
+        m_Value = (m_Value < other.m_Value) ? Tp(difference + m_Modulus) : difference;
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp>
+    Montgomery<Tp>& Montgomery<Tp>::operator*=(Montgomery<Tp> const& other)
+    {
+        m_Value = reduce(Wide(m_Value) * other.m_Value);
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp>
+    Barrett<Tp>::Barrett(Tp const& mod)
+        : Barrett{mod,0}
+    {
+    }
+
+    template <std::unsigned_integral Tp>
+    Barrett<Tp>::Barrett(Tp const& mod, Tp const& val)
+        : m_Modulus{mod}
+    {
+        if (mod == 0 || mod-1 >= Tp(1) << (bits-1)) throw std::invalid_argument("mpp::Barrett");
+        m_Reciprocal = modular::barrett_reciprocal(mod);
+        m_Shift = modular::barrett_shift(mod);
+        m_Value = Tp(val % mod);
+    }
+
+    template <std::unsigned_integral Tp>
+    Barrett<Tp>::Barrett(Mod<Tp> const& other)
+        : Barrett{other.modulus(),other.value()}
+    {
+    }
+
+    template <std::unsigned_integral Tp>
+    Barrett<Tp>::operator Mod<Tp>() const
+    {
+        return Mod<Tp>{m_Modulus,m_Value};
+    }
+
+    template <std::unsigned_integral Tp>
+    void Barrett<Tp>::swap(Barrett<Tp>& other)
+    {
+        std::swap(m_Modulus,other.m_Modulus);
+        std::swap(m_Reciprocal,other.m_Reciprocal);
+        std::swap(m_Shift,other.m_Shift);
+        std::swap(m_Value,other.m_Value);
+    }
+
+    template <std::unsigned_integral Tp>
+    Barrett<Tp>& Barrett<Tp>::operator+=(Barrett<Tp> const& other)
+    {
+        // both are below 2^(bits-1), so the sum cannot wrap
+        Tp const sum = Tp(m_Value + other.m_Value);
+        m_Value = (sum >= m_Modulus) ? Tp(sum - m_Modulus) : sum;
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp>
+    Barrett<Tp>& Barrett<Tp>::operator-=(Barrett<Tp> const& other)
+    {
+        Tp const difference = Tp(m_Value - other.m_Value);
+        m_Value = (m_Value < other.m_Value) ? Tp(difference + m_Modulus) : difference;
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp>
+    Barrett<Tp>& Barrett<Tp>::operator*=(Barrett<Tp> const& other)
+    {
+        m_Value = modular::barrett_reduce<Tp>(Wide(m_Value) * other.m_Value,m_Modulus,m_Reciprocal,m_Shift);
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr StaticMod<Tp,M>::StaticMod(Tp const& val)
+        : m_Value{Tp(val % M)}
+    {
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr StaticMod<Tp,M>::StaticMod(Mod<Tp> const& other)
+        : m_Value{other.value()}
+    {
+        // residues of another modulus are not residues of this one
+        if (other.modulus() != M) throw std::invalid_argument("mpp::StaticMod");
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    StaticMod<Tp,M>::operator Mod<Tp>() const
+    {
+        return Mod<Tp>{M,m_Value};
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr auto StaticMod<Tp,M>::operator++()
+        -> StaticMod&
+    {
+        m_Value = (m_Value == M-1) ? Tp(0) : Tp(m_Value + 1);
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr auto StaticMod<Tp,M>::operator--()
+        -> StaticMod&
+    {
+        m_Value = (m_Value == 0) ? Tp(M-1) : Tp(m_Value - 1);
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr auto StaticMod<Tp,M>::operator+=(StaticMod const& other)
+        -> StaticMod&
+    {
+        // both are below 2^(bits-1), so the sum cannot wrap
+        Tp const sum = Tp(m_Value + other.m_Value);
+        m_Value = (sum >= M) ? Tp(sum - M) : sum;
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr auto StaticMod<Tp,M>::operator-=(StaticMod const& other)
+        -> StaticMod&
+    {
+        Tp const difference = Tp(m_Value - other.m_Value);
+        m_Value = (m_Value < other.m_Value) ? Tp(difference + M) : difference;
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr auto StaticMod<Tp,M>::operator*=(StaticMod const& other)
+        -> StaticMod&
+    {
+        m_Value = modular::barrett_reduce<Tp>(Wide(m_Value) * other.m_Value,M,reciprocal,shift);
+        return *this;
+    }
+
+    template <std::unsigned_integral Tp, Tp M>
+        requires (M > 0 && M <= Tp(1) << (std::numeric_limits<Tp>::digits-1))
+    constexpr auto StaticMod<Tp,M>::operator/=(StaticMod const& other)
+        -> StaticMod&
+    {
+        // by the inverse, which throws for divisors sharing a factor with M
+        return *this *= inverse<StaticMod,op_mul>::get(other);
+    }
+
+    namespace modular
+    {
+
+        // the multiplicative identity of the ring `e` lies in
+        template <typename Tm>
+        auto unit(Tm const& e) -> Tm
+        {
+            if constexpr (requires { identity<Tm,op_mul>::get(); })
+            {
+                return identity<Tm,op_mul>::get();
+            }
+            else
+            {
+                return identity<Tm,op_mul>::get(e.modulus());
+            }
+        }
+
+        template <typename Tm, std::unsigned_integral Te>
+        auto pow_window(Tm const& base, Te const& exponent) -> Tm
+        {
+            int const n = std::bit_width(exponent);
+            if (n == 0) return unit(base);
+            int const w = window(n);
+
+            // the odd powers b, b^3, ..., b^(2^w - 1)
+            auto odd = [&]<size_t... I>(std::index_sequence<I...>) {
+                return std::array<Tm,sizeof...(I)>{((void)I,base)...};
+            }(std::make_index_sequence<8>{});
+            auto const square = base * base;
+            for (int i = 1; i < (1 << (w-1)); ++i) odd[i] = odd[i-1] * square;
+
+            auto result = base;
+            bool started = false;
+            for (int i = n-1; i >= 0; )
+            {
+                if (((exponent >> i) & 1) == 0)
+                {
+                    result *= result;
+                    i -= 1;
+                    continue;
+                }
+
+                // the longest window from bit i that ends on a set bit
+                int j = std::max(i-w+1,0);
+                while (((exponent >> j) & 1) == 0) ++j;
+                auto const digit = size_t((exponent >> j) & ((Te(1) << (i-j+1)) - 1));
+
+                if (started)
+                {
+                    for (int k = i; k >= j; --k) result *= result;
+                    result *= odd[digit/2];
+                }
+                else
+                {
+                    result = odd[digit/2];
+                    started = true;
+                }
+                i = j-1;
+            }
+            return result;
+        }
+
+        template <typename Tm, std::unsigned_integral Te>
+        auto multipow_straus(std::span<Tm const> bases, std::span<Te const> exponents) -> Tm
+        {
+            if (bases.size() != exponents.size() || bases.empty())
+            {
+                throw std::invalid_argument("mpp::modular::multipow");
+            }
+
+            int n = 0;
+            for (auto const& e : exponents) n = std::max(n,int(std::bit_width(e)));
+            if (n == 0) return unit(bases[0]);
+
+            // every power b^d for d below 2^w, base by base
+            int const w = std::min(window(n),bases.size() > 4 ? 2 : 4);
+            size_t const width = size_t(1) << w;
+            auto table = std::vector<Tm>{};
+            table.reserve(bases.size() * width);
+            for (auto const& b : bases)
+            {
+                table.push_back(unit(b));
+                for (size_t d = 1; d < width; ++d) table.push_back(table.back() * b);
+            }
+
+            auto result = unit(bases[0]);
+            bool started = false;
+            for (int p = (n-1) / w; p >= 0; --p)
+            {
+                if (started)
+                {
+                    for (int k = 0; k < w; ++k) result *= result;
+                }
+                for (size_t i = 0; i < bases.size(); ++i)
+                {
+                    auto const digit = size_t((exponents[i] >> (p*w)) & Te(width-1));
+                    if (digit == 0) continue;
+                    if (started) result *= table[i*width+digit];
+                    else result = table[i*width+digit];
+                    started = true;
+                }
+            }
+            return result;
+        }
+
+        template <typename Tm, std::unsigned_integral Te>
+        auto pow(Tm const& base, Te const& exponent)
+            -> Tm
+        {
+            return pow_window(base,exponent);
+        }
+
+        template <typename Tp, std::unsigned_integral Te>
+        auto pow(Mod<Tp> const& base, Te const& exponent)
+            -> Mod<Tp>
+        {
+            if constexpr (std::unsigned_integral<Tp>)
+            {
+                Tp const& m = base.modulus();
+                if (m % 2 == 1)
+                {
+                    return static_cast<Mod<Tp>>(pow_window(Montgomery<Tp>{base},exponent));
+                }
+                if (m != 0 && m-1 < Tp(1) << (std::numeric_limits<Tp>::digits-1))
+                {
+                    return static_cast<Mod<Tp>>(pow_window(Barrett<Tp>{base},exponent));
+                }
+            }
+            return pow_window(base,exponent);
+        }
+
+        template <typename Tm, std::unsigned_integral Te>
+        auto multipow(std::span<Tm const> bases, std::span<Te const> exponents)
+            -> Tm
+        {
+            return multipow_straus(bases,exponents);
+        }
+
+        template <typename Tp, std::unsigned_integral Te>
+        auto multipow(std::span<Mod<Tp> const> bases, std::span<Te const> exponents)
+            -> Mod<Tp>
+        {
+            if constexpr (std::unsigned_integral<Tp>)
+            {
+                if (!bases.empty() && bases[0].modulus() % 2 == 1)
+                {
+                    auto forms = std::vector<Montgomery<Tp>>{bases.begin(),bases.end()};
+                    auto const result = multipow_straus(std::span<Montgomery<Tp> const>{forms},exponents);
+                    return static_cast<Mod<Tp>>(result);
+                }
+            }
+            return multipow_straus(bases,exponents);
+        }
+
+        constexpr auto window(int n)
+            -> int
+        {
+            return (n > 79) ? 4 : (n > 23) ? 3 : (n > 7) ? 2 : 1;
+        }
+
+        // the inverse of `e`, or nothing, by a single extended gcd where the
+        // residue exposes its value and an unsigned modulus
+        template <typename Tm>
+        auto try_inverse(Tm const& e)
+            -> std::optional<Tm>
+        {
+            if constexpr (requires { { invert(e.value(),e.modulus()) } -> std::same_as<std::optional<std::remove_cvref_t<decltype(e.value())>>>; })
+            {
+                auto const x = invert(e.value(),e.modulus());
+                if (!x) return std::nullopt;
+                if constexpr (requires { Tm::modulus(); }) {
+                    return Tm{*x};
+                } else {
+                    return Tm{e.modulus(),*x};
+                }
+            }
+            else
+            {
+                if (!inverse<Tm,op_mul>::can(e)) return std::nullopt;
+                return inverse<Tm,op_mul>::get(e);
+            }
+        }
+
+        template <typename Tm>
+        void invert_batch(std::span<Tm> values, size_t offset, std::vector<Tm>& prefix, std::vector<size_t>& failed)
+        {
+            if (values.empty()) return;
+
+            prefix.clear();
+            prefix.push_back(values[0]);
+            for (size_t i = 1; i < values.size(); ++i) prefix.push_back(prefix.back() * values[i]);
+
+            // a product shares a factor with the modulus when any element does
+            auto const total = try_inverse(prefix.back());
+            if (!total)
+            {
+                if (values.size() == 1)
+                {
+                    failed.push_back(offset);
+                    return;
+                }
+                size_t const half = values.size() / 2;
+                invert_batch(values.first(half),offset,prefix,failed);
+                invert_batch(values.subspan(half),offset+half,prefix,failed);
+                return;
+            }
+
+            auto rest = *total;
+            for (size_t i = values.size()-1; i > 0; --i)
+            {
+                auto const value = values[i];
+                values[i] = rest * prefix[i-1];
+                rest *= value;
+            }
+            values[0] = rest;
+        }
+
+        template <typename Tm>
+        auto invert(std::span<Tm> values)
+            -> std::vector<size_t>
+        {
+            auto prefix = std::vector<Tm>{};
+            prefix.reserve(values.size());
+            auto failed = std::vector<size_t>{};
+            invert_batch(values,0,prefix,failed);
+            return failed;
+        }
+
+        template <typename Tm>
+        Comb<Tm>::Comb(Tm const& base, int bits, int teeth)
+            : m_Teeth{teeth}
+            , m_Spacing{(bits + teeth - 1) / teeth}
+        {
+            if (bits < 1 || teeth < 1 || teeth > 16) throw std::invalid_argument("mpp::modular::Comb");
+
+            // the rows base^(2^(ja)), then every product of a subset of them
+            auto rows = std::vector<Tm>{base};
+            for (int j = 1; j < m_Teeth; ++j)
+            {
+                rows.push_back(rows.back());
+                for (int k = 0; k < m_Spacing; ++k) rows.back() *= rows.back();
+            }
+
+            m_Table.reserve(size_t(1) << m_Teeth);
+            m_Table.push_back(unit(base));
+            for (size_t s = 1; s < (size_t(1) << m_Teeth); ++s)
+            {
+                int const top = std::bit_width(s) - 1;
+                m_Table.push_back(m_Table[s ^ (size_t(1) << top)] * rows[top]);
+            }
+        }
+
+        template <typename Tm>
+        template <std::unsigned_integral Te>
+        auto Comb<Tm>::pow(Te const& exponent) const
+            -> Tm
+        {
+            if (int(std::bit_width(exponent)) > bits()) throw std::out_of_range("mpp::modular::Comb::pow");
+
+            auto result = m_Table[0];
+            bool started = false;
+            for (int i = m_Spacing-1; i >= 0; --i)
+            {
+                if (started) result *= result;
+
+                // the column of exponent bits i, i+a, i+2a, ...
+                size_t s = 0;
+                for (int j = 0; j < m_Teeth && j*m_Spacing+i < std::numeric_limits<Te>::digits; ++j)
+                {
+                    s |= size_t((exponent >> (j*m_Spacing+i)) & 1) << j;
+                }
+                if (s == 0) continue;
+                if (started) result *= m_Table[s];
+                else result = m_Table[s];
+                started = true;
+            }
+            return result;
+        }
+
+    } // namespace modular
+
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -566,8 +1575,8 @@ namespace mpp
     auto operator*(Mod<Tp> const& mod1, Mod<Tq> const& mod2)
     {
         using Tr = op_mul::result<Tp,Tq>::type;
-        auto value = mod1.value() * mod2.value();
         auto const d = gcd<Tr>(mod1.modulus(),mod2.modulus());
+        auto value = modular::multiply<Tr>(mod1.value(),mod2.value(),d);
         return Mod<Tr>{d,std::move(value)};
     }
 
@@ -575,7 +1584,7 @@ namespace mpp
         requires requires (Tp a, Tp b) { a * b; }
     auto operator*(Mod<Tp> const& mod, Tp const& c)
     {
-        auto value = mod.value() * c;
+        auto value = modular::multiply(mod.value(),c,mod.modulus());
         return Mod<Tp>{mod.modulus(),std::move(value)};
     }
 
@@ -583,7 +1592,7 @@ namespace mpp
         requires requires (Tp a, Tp b) { a * b; }
     auto operator*(Tp const& c, Mod<Tp> const& mod)
     {
-        auto value = c * mod.value();
+        auto value = modular::multiply(c,mod.value(),mod.modulus());
         return Mod<Tp>{mod.modulus(),std::move(value)};
     }
 
@@ -639,6 +1648,115 @@ namespace mpp
         return Mod<Tp>{mod.modulus(),std::move(value)};
     }
 
+    template <typename Tp>
+    bool operator==(Montgomery<Tp> const& mont1, Montgomery<Tp> const& mont2)
+    {
+        return mont1.modulus() == mont2.modulus() && mont1.form() == mont2.form();
+    }
+
+    template <typename Tp>
+    auto operator-(Montgomery<Tp> const& mont)
+    {
+        auto copy = Montgomery<Tp>{mont.modulus()};
+        return copy -= mont;
+    }
+
+    template <typename Tp>
+    auto operator+(Montgomery<Tp> const& mont1, Montgomery<Tp> const& mont2)
+    {
+        auto copy = mont1;
+        return copy += mont2;
+    }
+
+    template <typename Tp>
+    auto operator-(Montgomery<Tp> const& mont1, Montgomery<Tp> const& mont2)
+    {
+        auto copy = mont1;
+        return copy -= mont2;
+    }
+
+    template <typename Tp>
+    auto operator*(Montgomery<Tp> const& mont1, Montgomery<Tp> const& mont2)
+    {
+        auto copy = mont1;
+        return copy *= mont2;
+    }
+
+    template <typename Tp>
+    bool operator==(Barrett<Tp> const& bar1, Barrett<Tp> const& bar2)
+    {
+        return bar1.modulus() == bar2.modulus() && bar1.value() == bar2.value();
+    }
+
+    template <typename Tp>
+    auto operator-(Barrett<Tp> const& bar)
+    {
+        auto copy = Barrett<Tp>{bar.modulus()};
+        return copy -= bar;
+    }
+
+    template <typename Tp>
+    auto operator+(Barrett<Tp> const& bar1, Barrett<Tp> const& bar2)
+    {
+        auto copy = bar1;
+        return copy += bar2;
+    }
+
+    template <typename Tp>
+    auto operator-(Barrett<Tp> const& bar1, Barrett<Tp> const& bar2)
+    {
+        auto copy = bar1;
+        return copy -= bar2;
+    }
+
+    template <typename Tp>
+    auto operator*(Barrett<Tp> const& bar1, Barrett<Tp> const& bar2)
+    {
+        auto copy = bar1;
+        return copy *= bar2;
+    }
+
+    template <typename Tp, Tp M>
+    constexpr bool operator==(StaticMod<Tp,M> const& mod1, StaticMod<Tp,M> const& mod2)
+    {
+        return mod1.value() == mod2.value();
+    }
+
+    template <typename Tp, Tp M>
+    constexpr auto operator-(StaticMod<Tp,M> const& mod)
+    {
+        auto copy = StaticMod<Tp,M>{};
+        return copy -= mod;
+    }
+
+    template <typename Tp, Tp M>
+    constexpr auto operator+(StaticMod<Tp,M> const& mod1, StaticMod<Tp,M> const& mod2)
+    {
+        auto copy = mod1;
+        return copy += mod2;
+    }
+
+    template <typename Tp, Tp M>
+    constexpr auto operator-(StaticMod<Tp,M> const& mod1, StaticMod<Tp,M> const& mod2)
+    {
+        auto copy = mod1;
+        return copy -= mod2;
+    }
+
+    template <typename Tp, Tp M>
+    constexpr auto operator*(StaticMod<Tp,M> const& mod1, StaticMod<Tp,M> const& mod2)
+    {
+        auto copy = mod1;
+        return copy *= mod2;
+    }
+
+    template <typename Tp, Tp M>
+    constexpr auto operator/(StaticMod<Tp,M> const& mod1, StaticMod<Tp,M> const& mod2)
+    {
+        auto copy = mod1;
+        return copy /= mod2;
+    }
+
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -654,6 +1772,18 @@ namespace std
         mod1.swap(mod2);
     }
 
+    template <typename Tp>
+    void swap(mpp::Montgomery<Tp>& mont1, mpp::Montgomery<Tp>& mont2)
+    {
+        mont1.swap(mont2);
+    }
+
+    template <typename Tp>
+    void swap(mpp::Barrett<Tp>& bar1, mpp::Barrett<Tp>& bar2)
+    {
+        bar1.swap(bar2);
+    }
+
 } // namespace std
 
 #endif /* __HH_MPP_MOD */
@@ -0,0 +1,324 @@
+
+#ifndef __HH_MPP_PARALLEL
+#define __HH_MPP_PARALLEL
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <algorithm>
+#include <exception>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * A work-stealing thread pool. Every worker owns a queue of tasks, taking
+     * its newest task first and stealing the oldest tasks of other workers
+     * when its own queue runs dry. Threads waiting on a parallel loop help run
+     * queued tasks rather than block, so loops may nest.
+     */
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t workers = default_workers());
+        ~ThreadPool();
+
+        ThreadPool(ThreadPool const&) = delete;
+        ThreadPool& operator=(ThreadPool const&) = delete;
+
+        static ThreadPool& global();
+        static size_t default_workers();
+
+    public:
+        auto workers() const { return m_Threads.size(); }
+
+        // calls `fn(lo,hi)` over disjoint chunks of at most `grain` indices
+        template <typename Fn>
+        void parallel_for(size_t begin, size_t end, size_t grain, Fn&& fn);
+
+    private:
+        using Task = std::function<void()>;
+
+        struct Queue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        size_t self() const;
+        void push(Task);
+        bool pop(Task&);
+        void run(size_t);
+
+    private:
+        std::vector<std::unique_ptr<Queue>> m_Queues;
+        std::vector<std::thread> m_Threads;
+        std::atomic<size_t> m_Pending{0};
+        std::atomic<size_t> m_Next{0};
+        std::mutex m_Mutex;
+        std::condition_variable m_Wake;
+        bool m_Stop = false;
+
+        // the pool and queue of the calling thread, when it is a worker
+        inline static thread_local ThreadPool const* t_WorkerPool = nullptr;
+        inline static thread_local size_t t_WorkerIndex = 0;
+    };
+
+    /*
+     * Execution policies for the algorithms that can run in parallel. The
+     * sequenced policy runs inline, and in constant expressions. The parallel
+     * policy runs on a pool, the global pool unless one is given, splitting
+     * work into chunks of `grain` rows, or of a size chosen from the work
+     * when `grain` is zero. Each output element is computed by exactly one
+     * task, in the same order as when sequenced, so results do not depend on
+     * the number of threads.
+     */
+    namespace execution
+    {
+
+        struct sequenced_policy
+        {
+            template <typename Fn>
+            constexpr void for_each(size_t begin, size_t end, size_t, Fn&& fn) const
+            {
+                if (begin < end) fn(begin,end);
+            }
+        };
+
+        struct parallel_policy
+        {
+            ThreadPool* pool = nullptr;
+            size_t grain = 0;
+
+            constexpr parallel_policy on(ThreadPool& p) const { return {&p,grain}; }
+            constexpr parallel_policy with_grain(size_t g) const { return {pool,g}; }
+
+            template <typename Fn>
+            void for_each(size_t begin, size_t end, size_t min_grain, Fn&& fn) const;
+        };
+
+        inline constexpr sequenced_policy seq{};
+        inline constexpr parallel_policy par{};
+
+        // the least work, in multiply-adds, worth handing to another thread
+        constexpr size_t min_work = 1 << 14;
+
+        // the least number of items of `width` multiply-adds for one chunk
+        constexpr size_t grain_for(size_t width)
+        {
+            return std::max<size_t>(min_work / std::max<size_t>(width,1), 1);
+        }
+
+    } // namespace execution
+
+    template <typename Tp>
+    concept execution_policy = std::is_same<std::remove_cvref_t<Tp>,execution::sequenced_policy>::value
+        || std::is_same<std::remove_cvref_t<Tp>,execution::parallel_policy>::value;
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    inline ThreadPool::ThreadPool(size_t workers)
+    {
+        for (size_t i = 0; i < workers; ++i)
+        {
+            m_Queues.push_back(std::make_unique<Queue>());
+        }
+        for (size_t i = 0; i < workers; ++i)
+        {
+            m_Threads.emplace_back([this,i]{ run(i); });
+        }
+    }
+
+    inline ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard lock{m_Mutex};
+            m_Stop = true;
+        }
+        m_Wake.notify_all();
+
+        for (auto& thread : m_Threads)
+        {
+            thread.join();
+        }
+    }
+
+    inline ThreadPool& ThreadPool::global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    inline size_t ThreadPool::default_workers()
+    {
+        // the calling thread takes part, so leave it a core
+        size_t const cores = std::thread::hardware_concurrency();
+        return (cores > 1) ? cores-1 : 0;
+    }
+
+    inline size_t ThreadPool::self() const
+    {
+        // the queue of the calling thread, if it is one of our workers
+        return (t_WorkerPool == this) ? t_WorkerIndex : m_Queues.size();
+    }
+
+    inline void ThreadPool::push(Task task)
+    {
+        size_t const index = (self() < m_Queues.size())
+            ? self()
+            : m_Next.fetch_add(1,std::memory_order_relaxed) % m_Queues.size();
+        {
+            std::lock_guard lock{m_Queues[index]->mutex};
+            m_Queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard lock{m_Mutex};
+            m_Pending.fetch_add(1,std::memory_order_release);
+        }
+        m_Wake.notify_one();
+    }
+
+    inline bool ThreadPool::pop(Task& task)
+    {
+        size_t const count = m_Queues.size();
+        size_t const home = (self() < count) ? self() : 0;
+
+        // the newest task of our own queue, for locality
+        if (self() < count)
+        {
+            auto& queue = *m_Queues[home];
+            std::lock_guard lock{queue.mutex};
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+                m_Pending.fetch_sub(1,std::memory_order_relaxed);
+                return true;
+            }
+        }
+        // otherwise the oldest task of another queue
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto& queue = *m_Queues[(home+i) % count];
+            std::lock_guard lock{queue.mutex};
+            if (!queue.tasks.empty())
+            {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+                m_Pending.fetch_sub(1,std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    inline void ThreadPool::run(size_t index)
+    {
+        t_WorkerPool = this;
+        t_WorkerIndex = index;
+
+        Task task;
+        while (true)
+        {
+            if (pop(task))
+            {
+                task();
+                continue;
+            }
+            std::unique_lock lock{m_Mutex};
+            m_Wake.wait(lock,[this]{ return m_Stop || m_Pending.load(std::memory_order_acquire) > 0; });
+            if (m_Stop) return;
+        }
+    }
+
+    template <typename Fn>
+    void ThreadPool::parallel_for(size_t begin, size_t end, size_t grain, Fn&& fn)
+    {
+        if (begin >= end) return;
+
+        grain = std::max<size_t>(grain,1);
+        size_t const chunks = (end - begin + grain - 1) / grain;
+
+        if (chunks == 1 || m_Queues.empty())
+        {
+            fn(begin,end);
+            return;
+        }
+
+        std::atomic<size_t> remaining{chunks};
+        std::exception_ptr error;
+        std::mutex error_mutex;
+
+        auto chunk = [&](size_t lo, size_t hi)
+        {
+            try {
+                fn(lo,hi);
+            } catch (...) {
+                std::lock_guard lock{error_mutex};
+                if (!error) error = std::current_exception();
+            }
+            remaining.fetch_sub(1,std::memory_order_release);
+        };
+
+        // queue all but the first chunk, which the caller runs itself
+        for (size_t lo = begin + grain; lo < end; lo += grain)
+        {
+            size_t const hi = std::min(lo+grain,end);
+            push([&chunk,lo,hi]{ chunk(lo,hi); });
+        }
+        chunk(begin,std::min(begin+grain,end));
+
+        // help with queued work until every chunk has finished
+        Task task;
+        while (remaining.load(std::memory_order_acquire) > 0)
+        {
+            if (pop(task)) {
+                task();
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        if (error) std::rethrow_exception(error);
+    }
+
+    namespace execution
+    {
+
+        template <typename Fn>
+        void parallel_policy::for_each(size_t begin, size_t end, size_t min_grain, Fn&& fn) const
+        {
+            if (begin >= end) return;
+
+            auto& target = pool ? *pool : ThreadPool::global();
+            size_t const threads = target.workers() + 1;
+
+            // by default, a few chunks per thread to even out the load, but no
+            // smaller than the least worth sharing; an explicit grain wins
+            size_t const chunk = grain ? grain
+                : std::max((end - begin + 4*threads - 1) / (4*threads), min_grain);
+
+            target.parallel_for(begin,end,chunk,std::forward<Fn>(fn));
+        }
+
+    } // namespace execution
+
+} // namespace mpp
+
+#endif /* __HH_MPP_PARALLEL */
@@ -3,10 +3,18 @@
 #define __HH_MPP_POLY
 
 #include "mathpp/mathpp.hh"
+#include "mathpp/fft.hh"
+#include "mathpp/simd.hh"
 
+#include <bit>
+#include <atomic>
+#include <span>
+#include <limits>
 #include <vector>
 #include <tuple>
+#include <utility>
 #include <algorithm>
+#include <stdexcept>
 #include <compare>
 
 /* ************************************************************************** */
@@ -17,12 +25,11 @@ namespace mpp
 {
 
     template <typename Tp>
-    class Poly
+    class Poly final
     {
     public:
         explicit Poly();
         explicit Poly(size_t, Tp const&);
-        virtual ~Poly() = default;
 
         Poly(std::initializer_list<Tp>);
         Poly(std::vector<Tp> const&);
@@ -34,42 +41,53 @@ namespace mpp
         template <typename Tq>
         Poly<Tp>& operator=(Poly<Tq> const&);
 
-    protected:
-        virtual void validate();
+        Poly(Poly<Tp> const&);
+        Poly(Poly<Tp>&&) noexcept;
+        Poly<Tp>& operator=(Poly<Tp> const&);
+        Poly<Tp>& operator=(Poly<Tp>&&) noexcept;
+
+    private:
+        void validate();
+
+        // the coefficient of every power past the end
+        static auto absent() -> Tp const&;
 
     public:
-        virtual void trim();
-
-        virtual auto coeffs() const -> std::vector<Tp> const& { return m_Coefficients; }
-        virtual auto coeffs() -> std::vector<Tp>& { return m_Coefficients; }
-        virtual auto size() const -> size_t { return m_Coefficients.size(); }
-
-        virtual auto order() const -> size_t;
-        virtual auto front() const -> Tp const& { return m_Coefficients[0]; }
-        virtual auto back() const -> Tp const& { return m_Coefficients[order()]; }
-
-        virtual void swap(Poly<Tp>&);
-        virtual void assign(size_t, Tp const&);
-        virtual void assign(std::initializer_list<Tp>);
-        virtual void assign(std::vector<Tp> const&);
-        virtual void assign(std::vector<Tp>&&);
-        virtual void resize(size_t);
-        virtual void resize(size_t, Tp const&);
-        virtual void zero();
-
-        virtual auto operator[](size_t i) const -> Tp const&;
-        virtual auto operator[](size_t i) -> Tp&;
-        virtual auto at(size_t i) const -> Tp const&;
-        virtual auto at(size_t i) -> Tp&;
-
-        virtual Poly<Tp>& operator<<=(size_t);
-        virtual Poly<Tp>& operator>>=(size_t);
-
-        virtual Poly<Tp>& operator+=(Tp const&);
-        virtual Poly<Tp>& operator-=(Tp const&);
-        virtual Poly<Tp>& operator*=(Tp const&);
-        virtual Poly<Tp>& operator/=(Tp const&);
-        virtual Poly<Tp>& operator%=(Tp const&);
+        void trim();
+
+        auto coeffs() const -> std::vector<Tp> const& { return m_Coefficients; }
+        auto coeffs() -> std::vector<Tp>& { m_Order = exposed; return m_Coefficients; }
+        auto size() const -> size_t { return m_Coefficients.size(); }
+
+        auto order() const -> size_t;
+        auto front() const -> Tp const& { return m_Coefficients[0]; }
+        auto back() const -> Tp const& { return m_Coefficients[order()]; }
+
+        void swap(Poly<Tp>&);
+        void assign(size_t, Tp const&);
+        void assign(std::initializer_list<Tp>);
+        void assign(std::vector<Tp> const&);
+        void assign(std::vector<Tp>&&);
+        void resize(size_t);
+        void resize(size_t, Tp const&);
+        void zero();
+
+        auto operator[](size_t i) const -> Tp const&;
+        auto operator[](size_t i) -> Tp&;
+        auto at(size_t i) const -> Tp const&;
+        auto at(size_t i) -> Tp&;
+
+        auto operator()(Tp const& x) const -> Tp;
+        auto operator()(std::span<Tp const> points) const -> std::vector<Tp>;
+
+        Poly<Tp>& operator<<=(size_t);
+        Poly<Tp>& operator>>=(size_t);
+
+        Poly<Tp>& operator+=(Tp const&);
+        Poly<Tp>& operator-=(Tp const&);
+        Poly<Tp>& operator*=(Tp const&);
+        Poly<Tp>& operator/=(Tp const&);
+        Poly<Tp>& operator%=(Tp const&);
 
         template <typename Tq>
         Poly<Tp>& operator+=(Poly<Tq> const&);
@@ -80,10 +98,225 @@ namespace mpp
         template <typename Tq>
         Poly<Tp>& operator%=(Poly<Tq> const&);
 
-    protected:
-        mutable std::vector<Tp> m_Coefficients{};
+    private:
+        std::vector<Tp> m_Coefficients{};
+
+        // the degree, found on demand and kept until a mutating member is called;
+        // it is not kept at all while a mutable reference handed out by coeffs(),
+        // [] or at() may be written, that is until the next mutating member call;
+        // const readers on many threads may race to store the same value
+        constexpr static size_t unknown = size_t(-1);
+        constexpr static size_t exposed = size_t(-2);
+        alignas(std::atomic_ref<size_t>::required_alignment) mutable size_t m_Order = unknown;
     };
 
+    namespace polynomials
+    {
+
+        /*
+         * Products of coefficient sequences, lowest degree first. The result
+         * holds `a.size() + b.size() - 1` coefficients and is overwritten.
+         * Long products are taken by transform where it is exact. Otherwise
+         * operands are split into balanced blocks and multiplied by Toom-3,
+         * Karatsuba, or schoolbook multiplication as their length falls.
+         */
+        template <typename Tr, typename Tp, typename Tq>
+        void multiply(std::span<Tr> result, std::span<Tp const> a, std::span<Tq const> b);
+
+        template <typename Tr, typename Tp, typename Tq>
+        void multiply_schoolbook(std::span<Tr> result, std::span<Tp const> a, std::span<Tq const> b);
+
+        template <typename Tp>
+        void multiply_karatsuba(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b, bool toom3 = true);
+
+        template <typename Tp>
+        void multiply_toom3(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b);
+
+        // the shorter operand lengths at which each method takes over
+        constexpr size_t karatsuba_threshold = 32;
+        constexpr size_t toom3_threshold = 160;
+
+        /*
+         * Division of coefficient sequences, lowest degree first, by a divisor
+         * whose last coefficient is nonzero. The dividend is reduced in place
+         * to the remainder, and the quotient, of `a.size() - b.size() + 1`
+         * coefficients, is written unless its span is empty. Long divisions by
+         * a unit leading coefficient multiply by the reciprocal of the reversed
+         * divisor, found by Newton iteration; others are done term by term, as
+         * are floating divisions whose leading coefficient does not outweigh
+         * the rest, where the reciprocal would grow without bound.
+         */
+        template <typename Tp>
+        void divide(std::span<Tp> a, std::span<Tp const> b, std::span<Tp> quotient);
+
+        template <typename Tp>
+        void divide_classical(std::span<Tp> a, std::span<Tp const> b, std::span<Tp> quotient);
+
+        template <typename Tp>
+        void divide_newton(std::span<Tp> a, std::span<Tp const> b, std::span<Tp> quotient);
+
+        // by a divisor of the given (exponent, coefficient) terms, the last leading
+        template <typename Tp>
+        void divide_sparse(std::span<Tp> a, std::span<std::pair<size_t,Tp> const> b, std::span<Tp> quotient);
+
+        // the least ratio of divisor length to nonzero terms for dividing sparsely
+        constexpr size_t sparse_ratio = 8;
+
+        // the power series inverse of `a` modulo x^n, for a unit constant term
+        template <typename Tp>
+        auto reciprocal(std::span<Tp const> a, size_t n) -> std::vector<Tp>;
+
+        // drops the zero coefficients above the leading one
+        template <typename Tp>
+        void trim(std::vector<Tp>& coeffs);
+
+        // the shorter of the divisor and quotient lengths at which Newton takes over
+        constexpr size_t newton_threshold = 1024;
+
+        /*
+         * Reduction modulo a fixed divisor, for many dividends. The divisor is
+         * inspected once: a unit leading coefficient is inverted, so that each
+         * term costs a multiplication rather than a division, and long divisors
+         * keep the reciprocal of their reversal, so that each block of quotient
+         * terms costs two products (Barrett reduction). Dividends are reduced
+         * in place in scratch the reducer keeps, so one serves one thread.
+         */
+        template <typename Tp>
+        class Reducer
+        {
+        public:
+            explicit Reducer(Poly<Tp> const&);
+
+        public:
+            auto divisor() const -> std::vector<Tp> const& { return m_Divisor; }
+            bool barrett() const { return !m_Reciprocal.empty(); }
+
+            // reduces in place to the remainder, as `divide` would
+            void reduce(std::span<Tp>);
+            void reduce(Poly<Tp>&);
+
+            // reduces every polynomial of the batch
+            void reduce(std::span<Poly<Tp>>);
+
+        private:
+            void reduce_classical(std::span<Tp>) const;
+            void reduce_barrett(std::span<Tp>, size_t);
+
+        private:
+            std::vector<Tp> m_Divisor;
+            std::vector<Tp> m_Reciprocal;
+            Tp m_Inverse{};
+            bool m_Unit = false;
+
+            std::vector<Tp> m_Reversed, m_Quotient, m_Product;
+        };
+
+        // the divisor length at which a reducer takes blocks by Barrett reduction
+        constexpr size_t barrett_threshold = 256;
+
+        /*
+         * Evaluation of coefficient sequences, lowest degree first, by Horner's
+         * rule. At many points, several points are carried through each step
+         * together, in vector registers where the type allows. Long sequences
+         * of an integral type at many points go down a subproduct tree
+         * instead, reduced modulo the products of ever fewer (x - x_j) until
+         * each remainder is short enough to evaluate directly.
+         */
+        template <typename Tp>
+        auto evaluate(std::span<Tp const> coeffs, Tp const& x) -> Tp;
+
+        template <typename Tp>
+        void evaluate(std::span<Tp const> coeffs, std::span<Tp const> points, std::span<Tp> values);
+
+        template <typename Tp>
+        void evaluate_horner(std::span<Tp const> coeffs, std::span<Tp const> points, std::span<Tp> values);
+
+        template <typename Tp>
+        void evaluate_tree(std::span<Tp const> coeffs, std::span<Tp const> points, std::span<Tp> values);
+
+        // the fewest coefficients and points at which the tree takes over
+        constexpr size_t tree_threshold = 1 << 16;
+
+        /*
+         * The products of (x - x_j) over aligned blocks of points, paired a
+         * level at a time up to the product over all of them. Built once, it
+         * evaluates at its points by reducing modulo ever smaller products,
+         * and interpolates through them by combining up the same products.
+         */
+        template <typename Tp>
+        class SubproductTree
+        {
+        public:
+            explicit SubproductTree(std::span<Tp const>);
+
+        public:
+            auto points() const -> std::vector<Tp> const& { return m_Points; }
+            auto root() const -> std::vector<Tp> const& { return m_Levels.back().front(); }
+
+            // values[j] = f(x_j)
+            void evaluate(std::span<Tp const> coeffs, std::span<Tp> values) const;
+
+            // the sum of weights[j] times the root over (x - x_j), of points().size() terms
+            void combine(std::span<Tp const> weights, std::span<Tp> coeffs) const;
+
+            // the points of each leaf, whose remainders are evaluated directly
+            constexpr static size_t leaf = 64;
+
+        private:
+            void descend(size_t depth, size_t index, std::vector<Tp> rem, std::span<Tp> values) const;
+
+        private:
+            std::vector<Tp> m_Points;
+            std::vector<std::vector<std::vector<Tp>>> m_Levels;
+        };
+
+        /*
+         * Interpolation through distinct points, writing the polynomial of
+         * `points.size()` coefficients whose values at the points are given.
+         * Few points, and floating points, are interpolated by Newton's divided
+         * differences, which need nothing but field arithmetic. Many points of
+         * an exact field go up a subproduct tree, weighting each value by the
+         * inverse derivative of the product of (x - x_j) at its point.
+         */
+        template <typename Tp>
+        void interpolate(std::span<Tp const> points, std::span<Tp const> values, std::span<Tp> coeffs);
+
+        template <typename Tp>
+        void interpolate_newton(std::span<Tp const> points, std::span<Tp const> values, std::span<Tp> coeffs);
+
+        template <typename Tp>
+        void interpolate_tree(std::span<Tp const> points, std::span<Tp const> values, std::span<Tp> coeffs);
+
+        // the number of points at which the tree takes over
+        constexpr size_t interpolation_threshold = 32;
+
+        /*
+         * Interpolation through fixed points, for many sets of values. The
+         * tree and the weight of every point are found once, leaving each
+         * interpolation a single pass up the tree.
+         */
+        template <typename Tp>
+        class Interpolator
+        {
+        public:
+            explicit Interpolator(std::span<Tp const>);
+
+        public:
+            auto tree() const -> SubproductTree<Tp> const& { return m_Tree; }
+
+            void interpolate(std::span<Tp const> values, std::span<Tp> coeffs) const;
+            auto interpolate(std::span<Tp const> values) const -> Poly<Tp>;
+
+            // interpolates every set of values in the batch
+            auto interpolate(std::span<std::vector<Tp> const> batch) const -> std::vector<Poly<Tp>>;
+
+        private:
+            SubproductTree<Tp> m_Tree;
+            std::vector<Tp> m_Weights;
+        };
+
+    } // namespace polynomials
+
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -151,21 +384,499 @@ namespace mpp
         constexpr static auto get(Poly<Tp> const& poly1, Poly<Tq> const& poly2)
         {
             using Tr = op_mul::result<Tp,Tq>::type;
-            Poly<Tr> remainder = poly1;
-            Poly<Tr> quotient;
+            auto const zero = identity<Tr,op_add>::get();
+
+            auto remainder = std::vector<Tr>(poly1.coeffs().begin(),poly1.coeffs().begin()+poly1.order()+1);
+            auto const divisor = std::vector<Tr>(poly2.coeffs().begin(),poly2.coeffs().begin()+poly2.order()+1);
+            auto quotient = std::vector<Tr>(std::max(remainder.size()+1,divisor.size())-divisor.size(),zero);
 
-            using abs = absolute<Poly<Tp>,op_add>;
-            while (abs::get(remainder) >= abs::get(poly2))
+            polynomials::divide(std::span<Tr>{remainder},std::span<Tr const>{divisor},std::span<Tr>{quotient});
+            polynomials::trim(remainder);
+            return std::make_tuple(Poly<Tr>{std::move(remainder)},Poly<Tr>{std::move(quotient)});
+        }
+    };
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Namespace Functions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace polynomials
+    {
+
+        template <typename Tp>
+        concept ring = requires (Tp a, Tp b) { a + b; a - b; a * b; };
+
+        // Toom-3 interpolation divides exactly by 2 and 3
+        template <typename Tp>
+        concept toom3_ring = ring<Tp> && std::is_arithmetic<Tp>::value
+            && std::is_signed<Tp>::value;
+
+        // products by Toom-3 are exact only while no intermediate overflows
+        template <typename Tp>
+        void multiply_balanced(Tp* result, Tp const* a, Tp const* b, size_t n, bool toom3 = true);
+
+        template <typename Tp>
+        bool toom3_exact(std::span<Tp const> a, std::span<Tp const> b)
+        {
+            if constexpr (std::is_integral<Tp>::value && std::is_signed<Tp>::value)
             {
-                auto const coeff = remainder.back() / poly2.back();
-                auto const power = remainder.order() - poly2.order();
-                auto const term = Poly<Tr>{coeff} <<= power;
-                remainder -= term * poly2;
-                quotient += term;
+                auto const width = [](std::span<Tp const> x)
+                {
+                    using Tu = std::make_unsigned_t<Tp>;
+                    Tu bits = 0;
+                    for (auto const& c : x) bits |= (c < 0) ? Tu(0) - Tu(c) : Tu(c);
+                    return size_t(std::bit_width(bits));
+                };
+                // evaluation at -2 costs three bits per operand, interpolation one more
+                size_t const bits = width(a) + width(b) + std::bit_width(std::min(a.size(),b.size())) + 7;
+                return bits < size_t(std::numeric_limits<Tp>::digits);
             }
-            return std::make_tuple(remainder,quotient);
+            return true;
         }
-    };
+
+        template <typename Tr, typename Tp, typename Tq>
+        void multiply_schoolbook(std::span<Tr> result, std::span<Tp const> a, std::span<Tq const> b)
+        {
+            std::fill_n(result.begin(),a.size()+b.size()-1,identity<Tr,op_add>::get());
+
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                for (size_t j = 0; j < b.size(); ++j)
+                {
+                    result[i+j] += a[i] * b[j];
+                }
+            }
+        }
+
+        template <typename Tp>
+        void multiply_karatsuba(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b, bool toom3)
+        {
+            // a b = z0 + (z1 - z0 - z2) x^m + z2 x^2m, on halves of length m and h
+            size_t const n = a.size();
+            size_t const m = n / 2, h = n - m;
+            auto const zero = identity<Tp,op_add>::get();
+
+            auto z0 = result.subspan(0,2*m-1);
+            auto z2 = result.subspan(2*m,2*h-1);
+            result[2*m-1] = zero;
+            multiply_balanced(z0.data(),a.data(),b.data(),m,toom3);
+            multiply_balanced(z2.data(),a.data()+m,b.data()+m,h,toom3);
+
+            std::vector<Tp> sums(2*h,zero);
+            for (size_t i = 0; i < h; ++i)
+            {
+                sums[i] = (i < m) ? a[i] + a[m+i] : a[m+i];
+                sums[h+i] = (i < m) ? b[i] + b[m+i] : b[m+i];
+            }
+            std::vector<Tp> z1(2*h-1,zero);
+            multiply_balanced(z1.data(),sums.data(),sums.data()+h,h,toom3);
+
+            for (size_t i = 0; i < z0.size(); ++i) z1[i] -= z0[i];
+            for (size_t i = 0; i < z2.size(); ++i) z1[i] -= z2[i];
+            for (size_t i = 0; i < z1.size(); ++i) result[m+i] += z1[i];
+        }
+
+        template <typename Tp>
+        void multiply_toom3(std::span<Tp> result, std::span<Tp const> a, std::span<Tp const> b)
+        {
+            // a and b in three parts of length k, evaluated at 0, 1, -1, -2, and infinity
+            size_t const n = a.size();
+            size_t const k = (n + 2) / 3;
+            auto const zero = identity<Tp,op_add>::get();
+
+            auto const part = [&](std::span<Tp const> x, size_t i, size_t j)
+            {
+                return (i*k+j < n) ? x[i*k+j] : zero;
+            };
+
+            std::vector<Tp> points(10*k,zero);
+            for (size_t j = 0; j < k; ++j)
+            {
+                for (size_t s = 0; s < 2; ++s)
+                {
+                    auto const x = s ? b : a;
+                    auto const x0 = part(x,0,j), x1 = part(x,1,j), x2 = part(x,2,j);
+                    Tp* p = points.data() + s*5*k;
+                    p[0*k+j] = x0;
+                    p[1*k+j] = x0 + x1 + x2;
+                    p[2*k+j] = x0 - x1 + x2;
+                    p[3*k+j] = x0 - x1 - x1 + x2 + x2 + x2 + x2;
+                    p[4*k+j] = x2;
+                }
+            }
+
+            size_t const len = 2*k-1;
+            std::vector<Tp> values(5*len,zero);
+            for (size_t e = 0; e < 5; ++e)
+            {
+                multiply_balanced(values.data()+e*len,points.data()+e*k,points.data()+5*k+e*k,k);
+            }
+
+            // interpolation, after Bodrato
+            auto const two = identity<Tp,op_mul>::get() + identity<Tp,op_mul>::get();
+            auto const three = two + identity<Tp,op_mul>::get();
+            Tp* r0 = values.data();
+            Tp* r1 = r0 + len;
+            Tp* r2 = r1 + len;
+            Tp* r3 = r2 + len;
+            Tp* r4 = r3 + len;
+            for (size_t i = 0; i < len; ++i)
+            {
+                auto const v0 = r0[i], v1 = r1[i], vm1 = r2[i], vm2 = r3[i], vinf = r4[i];
+                auto c3 = (vm2 - v1) / three;
+                auto c1 = (v1 - vm1) / two;
+                auto c2 = vm1 - v0;
+                c3 = (c2 - c3) / two + two * vinf;
+                c2 = c2 + c1 - vinf;
+                c1 = c1 - c3;
+                r1[i] = c1; r2[i] = c2; r3[i] = c3;
+            }
+
+            std::fill_n(result.begin(),2*n-1,zero);
+            for (size_t e = 0; e < 5; ++e)
+            {
+                for (size_t i = 0; i < len && e*k+i < 2*n-1; ++i)
+                {
+                    result[e*k+i] += values[e*len+i];
+                }
+            }
+        }
+
+        template <typename Tp>
+        void multiply_balanced(Tp* result, Tp const* a, Tp const* b, size_t n, bool toom3)
+        {
+            auto const out = std::span<Tp>{result,2*n-1};
+            auto const x = std::span<Tp const>{a,n};
+            auto const y = std::span<Tp const>{b,n};
+
+            if (n < karatsuba_threshold) {
+                multiply_schoolbook(out,x,y);
+            } else if (n < toom3_threshold || !toom3) {
+                multiply_karatsuba(out,x,y,toom3);
+            } else if constexpr (toom3_ring<Tp>) {
+                multiply_toom3(out,x,y);
+            } else {
+                multiply_karatsuba(out,x,y);
+            }
+        }
+
+        template <typename Tr, typename Tp, typename Tq>
+        void multiply(std::span<Tr> result, std::span<Tp const> a, std::span<Tq const> b)
+        {
+            if (a.size() < b.size())
+            {
+                if constexpr (std::is_same<Tp,Tq>::value) {
+                    return multiply(result,b,a);
+                }
+            }
+            size_t const na = a.size(), nb = b.size();
+
+            if constexpr (std::is_same<Tp,Tr>::value && std::is_same<Tq,Tr>::value && ring<Tr>)
+            {
+                if constexpr (requires { fft::multiply(result,a,b); })
+                {
+                    // by transform where it is exact, else by Toom-Cook below
+                    if (std::min(na,nb) >= fft::threshold && fft::multiply(result,a,b)) return;
+                }
+                if (std::min(na,nb) >= karatsuba_threshold)
+                {
+                    // the longer operand in blocks the length of the shorter, wrapping
+                    // on overflow as the schoolbook would
+                    bool const toom3 = toom3_exact(a,b);
+                    auto const zero = identity<Tr,op_add>::get();
+                    std::fill_n(result.begin(),na+nb-1,zero);
+
+                    std::vector<Tr> block(2*nb-1,zero);
+                    for (size_t i = 0; i < na; i += nb)
+                    {
+                        size_t const len = std::min(nb,na-i);
+                        if (len == nb) {
+                            multiply_balanced(block.data(),a.data()+i,b.data(),nb,toom3);
+                        } else {
+                            multiply(std::span<Tr>{block}.first(len+nb-1),b,a.subspan(i,len));
+                        }
+                        for (size_t j = 0; j < len+nb-1; ++j)
+                        {
+                            result[i+j] += block[j];
+                        }
+                    }
+                    return;
+                }
+            }
+            else if constexpr (std::is_arithmetic<Tp>::value && std::is_arithmetic<Tq>::value
+                && std::is_same<std::common_type_t<Tp,Tq>,Tr>::value)
+            {
+                // mixed operands are promoted first, as the schoolbook would
+                if (std::min(na,nb) >= karatsuba_threshold)
+                {
+                    auto const x = std::vector<Tr>(a.begin(),a.end());
+                    auto const y = std::vector<Tr>(b.begin(),b.end());
+                    return multiply(result,std::span<Tr const>{x},std::span<Tr const>{y});
+                }
+            }
+            multiply_schoolbook(result,a,b);
+        }
+
+        template <typename Tp>
+        void trim(std::vector<Tp>& coeffs)
+        {
+            auto const pred = [](auto const& coeff){ return coeff != identity<Tp,op_add>::get(); };
+            coeffs.erase(std::find_if(coeffs.rbegin(),coeffs.rend(),pred).base(),coeffs.end());
+        }
+
+        template <typename Tp>
+        constexpr bool unit(Tp const& value)
+        {
+            if constexpr (inverse<Tp,op_mul>::has() == logic::all) {
+                return value != identity<Tp,op_add>::get();
+            } else {
+                auto const one = identity<Tp,op_mul>::get();
+                return value == one || identity<Tp,op_add>::get() - value == one;
+            }
+        }
+
+        template <typename Tp>
+        bool stable(std::span<Tp const> b)
+        {
+            // the reciprocal series stays bounded while the leading coefficient
+            // outweighs the rest; integral types wrap exactly regardless
+            if constexpr (std::is_floating_point<Tp>::value)
+            {
+                Tp rest = 0;
+                for (size_t i = 0; i+1 < b.size(); ++i) rest += std::abs(b[i]);
+                return rest < std::abs(b.back());
+            }
+            return true;
+        }
+
+        template <typename Tp>
+        void divide_classical(std::span<Tp> a, std::span<Tp const> b, std::span<Tp> quotient)
+        {
+            size_t const nb = b.size();
+            auto const& lead = b[nb-1];
+
+            // a leading term at a time, without forming shifted products
+            for (size_t i = a.size() - nb; i < a.size(); --i)
+            {
+                auto const coeff = a[i+nb-1] / lead;
+                if (!quotient.empty()) quotient[i] = coeff;
+                for (size_t j = 0; j < nb; ++j)
+                {
+                    a[i+j] -= coeff * b[j];
+                }
+            }
+        }
+
+        template <typename Tp>
+        auto reciprocal(std::span<Tp const> a, size_t n) -> std::vector<Tp>
+        {
+            auto const zero = identity<Tp,op_add>::get();
+            auto const two = identity<Tp,op_mul>::get() + identity<Tp,op_mul>::get();
+
+            // g <- g (2 - a g), doubling the correct terms every step
+            std::vector<Tp> g{identity<Tp,op_mul>::get() / a[0]};
+            std::vector<Tp> ag, gag;
+            for (size_t len = 1; len < n; )
+            {
+                len = std::min(2*len,n);
+
+                auto const head = a.first(std::min(a.size(),len));
+                ag.assign(head.size()+g.size()-1,zero);
+                multiply(std::span<Tp>{ag},head,std::span<Tp const>{g});
+                ag.resize(len,zero);
+
+                for (auto& c : ag) c = zero - c;
+                ag[0] += two;
+
+                gag.assign(ag.size()+g.size()-1,zero);
+                multiply(std::span<Tp>{gag},std::span<Tp const>{g},std::span<Tp const>{ag});
+                gag.resize(len);
+                g.swap(gag);
+            }
+            g.resize(n,zero);
+            return g;
+        }
+
+        template <typename Tp>
+        void divide_newton(std::span<Tp> a, std::span<Tp const> b, std::span<Tp> quotient)
+        {
+            size_t const na = a.size(), nb = b.size();
+            size_t const nq = na - nb + 1;
+            auto const zero = identity<Tp,op_add>::get();
+
+            // rev(q) = rev(a) / rev(b) modulo x^nq
+            auto const rb = std::vector<Tp>(b.rbegin(),b.rend());
+            auto const inv = reciprocal(std::span<Tp const>{rb},nq);
+            auto const ra = std::vector<Tp>(a.rbegin(),a.rbegin()+nq);
+
+            std::vector<Tp> rq(2*nq-1,zero);
+            multiply(std::span<Tp>{rq},std::span<Tp const>{ra},std::span<Tp const>{inv});
+            auto q = std::vector<Tp>(rq.rend()-nq,rq.rend());
+
+            // a - b q, of which only the low terms survive
+            std::vector<Tp> bq(nb+nq-1,zero);
+            multiply(std::span<Tp>{bq},b,std::span<Tp const>{q});
+            for (size_t i = 0; i < nb-1; ++i) a[i] -= bq[i];
+            std::fill(a.begin()+(nb-1),a.end(),zero);
+
+            if (!quotient.empty()) std::copy(q.begin(),q.end(),quotient.begin());
+        }
+
+        template <typename Tp>
+        void divide_sparse(std::span<Tp> a, std::span<std::pair<size_t,Tp> const> b, std::span<Tp> quotient)
+        {
+            size_t const nb = b.back().first + 1;
+            auto const& lead = b.back().second;
+
+            for (size_t i = a.size() - nb; i < a.size(); --i)
+            {
+                auto const coeff = a[i+nb-1] / lead;
+                if (!quotient.empty()) quotient[i] = coeff;
+                for (auto const& [exponent,value] : b)
+                {
+                    a[i+exponent] -= coeff * value;
+                }
+            }
+        }
+
+        template <typename Tp>
+        void divide(std::span<Tp> a, std::span<Tp const> b, std::span<Tp> quotient)
+        {
+            if (b.empty() || b.back() == identity<Tp,op_add>::get())
+            {
+                throw std::domain_error("mpp::polynomials::divide");
+            }
+            if (a.size() < b.size()) return;
+
+            // divisors of few terms, such as trinomials, touch only those terms
+            auto const zero = identity<Tp,op_add>::get();
+            size_t const count = b.size() - std::count(b.begin(),b.end(),zero);
+            if (count * sparse_ratio <= b.size())
+            {
+                std::vector<std::pair<size_t,Tp>> terms;
+                terms.reserve(count);
+                for (size_t j = 0; j < b.size(); ++j)
+                {
+                    if (b[j] != zero) terms.emplace_back(j,b[j]);
+                }
+                return divide_sparse(a,std::span<std::pair<size_t,Tp> const>{terms},quotient);
+            }
+
+            if constexpr (ring<Tp>)
+            {
+                size_t const nq = a.size() - b.size() + 1;
+                if (std::min(nq,b.size()) >= newton_threshold && unit(b.back()) && stable(b))
+                {
+                    return divide_newton(a,b,quotient);
+                }
+            }
+            divide_classical(a,b,quotient);
+        }
+
+        template <typename Tp>
+        auto evaluate(std::span<Tp const> coeffs, Tp const& x) -> Tp
+        {
+            Tp result = coeffs.back();
+            for (size_t i = coeffs.size()-1; i-- > 0; )
+            {
+                result = result * x + coeffs[i];
+            }
+            return result;
+        }
+
+        template <typename Tp>
+        void evaluate_horner(std::span<Tp const> coeffs, std::span<Tp const> points, std::span<Tp> values)
+        {
+            if constexpr (simd::supported<Tp>) {
+                simd::horner(coeffs.data(),coeffs.size(),points.data(),values.data(),points.size());
+            } else {
+                for (size_t j = 0; j < points.size(); ++j) values[j] = evaluate(coeffs,points[j]);
+            }
+        }
+
+        template <typename Tp>
+        void evaluate_tree(std::span<Tp const> coeffs, std::span<Tp const> points, std::span<Tp> values)
+        {
+            if (points.empty()) return;
+            SubproductTree<Tp>{points}.evaluate(coeffs,values);
+        }
+
+        template <typename Tp>
+        void evaluate(std::span<Tp const> coeffs, std::span<Tp const> points, std::span<Tp> values)
+        {
+            if constexpr (std::is_integral<Tp>::value)
+            {
+                if (std::min(coeffs.size(),points.size()) >= tree_threshold)
+                {
+                    return evaluate_tree(coeffs,points,values);
+                }
+            }
+            evaluate_horner(coeffs,points,values);
+        }
+
+        template <typename Tp>
+        void interpolate_newton(std::span<Tp const> points, std::span<Tp const> values, std::span<Tp> coeffs)
+        {
+            size_t const n = points.size();
+            if (n == 0) return;
+
+            // types inverting only some elements, such as residues, divide by inverse
+            auto const over = [](Tp const& a, Tp const& b) -> Tp
+            {
+                if constexpr (inverse<Tp,op_mul>::has() == logic::some) {
+                    return a * inverse<Tp,op_mul>::get(b);
+                } else {
+                    return a / b;
+                }
+            };
+
+            // divided differences, in place
+            std::vector<Tp> diffs(values.begin(),values.end());
+            for (size_t k = 1; k < n; ++k)
+            {
+                for (size_t i = n-1; i >= k; --i)
+                {
+                    diffs[i] = over(diffs[i] - diffs[i-1],points[i] - points[i-k]);
+                }
+            }
+
+            // the Newton form expanded by Horner's rule, a factor (x - x_k) at a time
+            coeffs[0] = diffs[n-1];
+            for (size_t k = n-1; k-- > 0; )
+            {
+                size_t const d = n-1-k;
+                coeffs[d] = coeffs[d-1];
+                for (size_t i = d-1; i > 0; --i) coeffs[i] = coeffs[i-1] - points[k] * coeffs[i];
+                coeffs[0] = diffs[k] - points[k] * coeffs[0];
+            }
+        }
+
+        template <typename Tp>
+        void interpolate_tree(std::span<Tp const> points, std::span<Tp const> values, std::span<Tp> coeffs)
+        {
+            if (points.empty()) return;
+            Interpolator<Tp>{points}.interpolate(values,coeffs);
+        }
+
+        template <typename Tp>
+        void interpolate(std::span<Tp const> points, std::span<Tp const> values, std::span<Tp> coeffs)
+        {
+            if constexpr (!std::is_floating_point<Tp>::value && requires { identity<Tp,op_add>::get(); })
+            {
+                if (points.size() >= interpolation_threshold)
+                {
+                    return interpolate_tree(points,values,coeffs);
+                }
+            }
+            interpolate_newton(points,values,coeffs);
+        }
+
+    } // namespace polynomials
 
 } // namespace mpp
 
@@ -247,6 +958,42 @@ namespace mpp
                 m_Coefficients.push_back(static_cast<Tp>(elem));
             }
         }
+        m_Order = unknown;
+        return *this;
+    }
+
+    template <typename Tp>
+    Poly<Tp>::Poly(Poly<Tp> const& other)
+        : m_Coefficients{other.m_Coefficients}
+        , m_Order{std::atomic_ref<size_t>{other.m_Order}.load(std::memory_order_relaxed)}
+    {
+        // references into the original are not references into the copy
+        if (m_Order == exposed) m_Order = unknown;
+    }
+
+    template <typename Tp>
+    Poly<Tp>::Poly(Poly<Tp>&& other) noexcept
+        : m_Coefficients{std::move(other.m_Coefficients)}
+        , m_Order{other.m_Order}
+    {
+        other.m_Order = unknown;
+    }
+
+    template <typename Tp>
+    Poly<Tp>& Poly<Tp>::operator=(Poly<Tp> const& other)
+    {
+        m_Coefficients = other.m_Coefficients;
+        m_Order = std::atomic_ref<size_t>{other.m_Order}.load(std::memory_order_relaxed);
+        if (m_Order == exposed) m_Order = unknown;
+        return *this;
+    }
+
+    template <typename Tp>
+    Poly<Tp>& Poly<Tp>::operator=(Poly<Tp>&& other) noexcept
+    {
+        m_Coefficients = std::move(other.m_Coefficients);
+        m_Order = other.m_Order;
+        other.m_Order = unknown;
         return *this;
     }
 
@@ -254,24 +1001,44 @@ namespace mpp
     void Poly<Tp>::validate()
     {
         if (m_Coefficients.size() == 0) m_Coefficients.push_back(identity<Tp,op_add>::get());
+        m_Order = unknown;
+    }
+
+    template <typename Tp>
+    auto Poly<Tp>::absent()
+        -> Tp const&
+    {
+        static Tp const zero = identity<Tp,op_add>::get();
+        return zero;
     }
 
     template <typename Tp>
     void Poly<Tp>::trim()
     {
-        m_Coefficients.erase(m_Coefficients.begin()+order(),m_Coefficients.end());
-        validate();
+        size_t const n = order();
+        m_Coefficients.erase(m_Coefficients.begin()+n+1,m_Coefficients.end());
+        m_Order = n;
     }
 
     template <typename Tp>
     auto Poly<Tp>::order() const
         -> size_t
     {
+        auto const cache = std::atomic_ref<size_t>{m_Order};
+        size_t const cached = cache.load(std::memory_order_relaxed);
+        if (cached != unknown && cached != exposed) return cached;
+
+        size_t n = 0;
         for (size_t i = m_Coefficients.size() - 1; i < m_Coefficients.size(); --i)
         {
-            if (m_Coefficients[i] != identity<Tp,op_add>::get()) return i;
+            if (m_Coefficients[i] != identity<Tp,op_add>::get())
+            {
+                n = i;
+                break;
+            }
         }
-        return 0;
+        if (cached == unknown) cache.store(n,std::memory_order_relaxed);
+        return n;
     }
 
     template <typename Tp>
@@ -335,8 +1102,7 @@ namespace mpp
     auto Poly<Tp>::operator[](size_t i) const
         -> Tp const&
     {
-        if (i >= m_Coefficients.size()) m_Coefficients.resize(i+1);
-        return m_Coefficients[i];
+        return (i < m_Coefficients.size()) ? m_Coefficients[i] : absent();
     }
 
     template <typename Tp>
@@ -344,6 +1110,7 @@ namespace mpp
         -> Tp&
     {
         if (i >= m_Coefficients.size()) m_Coefficients.resize(i+1);
+        m_Order = exposed;
         return m_Coefficients[i];
     }
 
@@ -351,8 +1118,7 @@ namespace mpp
     auto Poly<Tp>::at(size_t i) const
         -> Tp const&
     {
-        if (i >= m_Coefficients.size()) m_Coefficients.resize(i+1);
-        return m_Coefficients.at(i);
+        return (i < m_Coefficients.size()) ? m_Coefficients[i] : absent();
     }
 
     template <typename Tp>
@@ -360,6 +1126,7 @@ namespace mpp
         -> Tp&
     {
         if (i >= m_Coefficients.size()) m_Coefficients.resize(i+1);
+        m_Order = exposed;
         return m_Coefficients.at(i);
     }
 
@@ -379,6 +1146,22 @@ namespace mpp
         return *this;
     }
 
+    template <typename Tp>
+    auto Poly<Tp>::operator()(Tp const& x) const
+        -> Tp
+    {
+        return polynomials::evaluate(std::span<Tp const>{m_Coefficients},x);
+    }
+
+    template <typename Tp>
+    auto Poly<Tp>::operator()(std::span<Tp const> points) const
+        -> std::vector<Tp>
+    {
+        std::vector<Tp> values(points.size());
+        polynomials::evaluate(std::span<Tp const>{m_Coefficients},points,std::span<Tp>{values});
+        return values;
+    }
+
     template <typename Tp>
     Poly<Tp>& Poly<Tp>::operator<<=(size_t n)
     {
@@ -464,16 +1247,9 @@ namespace mpp
     template <typename Tq>
     Poly<Tp>& Poly<Tp>::operator*=(Poly<Tq> const& other)
     {
-        std::vector<Tp> coeffs;
-        coeffs.resize(size()*other.size());
-
-        for (size_t i = 0; i < size(); ++i)
-        {
-            for (size_t j = 0; j < other.size(); ++j)
-            {
-                coeffs[i+j] += m_Coefficients[i] * other[j];
-            }
-        }
+        auto coeffs = std::vector<Tp>(size()+other.size()-1,identity<Tp,op_add>::get());
+        polynomials::multiply(std::span<Tp>{coeffs},
+            std::span<Tp const>{m_Coefficients},std::span<Tq const>{other.coeffs()});
         assign(std::move(coeffs)); // validates
         return *this;
     }
@@ -482,17 +1258,292 @@ namespace mpp
     template <typename Tq>
     Poly<Tp>& Poly<Tp>::operator%=(Poly<Tq> const& other)
     {
-        using abs = absolute<Poly<Tp>,op_add>;
-        while (abs::get(*this) >= abs::get(other))
-        {
-            auto const coeff = back() / other.back();
-            auto const power = order() - other.order();
-            auto const term = Poly<Tp>{coeff} <<= power;
-            *this -= other * term;
-        }
+        auto const divisor = std::vector<Tp>(other.coeffs().begin(),other.coeffs().begin()+other.order()+1);
+
+        m_Coefficients.resize(order()+1);
+        polynomials::divide(std::span<Tp>{m_Coefficients},std::span<Tp const>{divisor},std::span<Tp>{});
+        polynomials::trim(m_Coefficients);
+        validate();
         return *this;
     }
 
+    namespace polynomials
+    {
+
+        template <typename Tp>
+        Reducer<Tp>::Reducer(Poly<Tp> const& divisor)
+            : m_Divisor(divisor.coeffs().begin(),divisor.coeffs().begin()+divisor.order()+1)
+        {
+            if (m_Divisor.back() == identity<Tp,op_add>::get())
+            {
+                throw std::domain_error("mpp::polynomials::Reducer");
+            }
+            size_t const nb = m_Divisor.size();
+            auto const& lead = m_Divisor.back();
+
+            if constexpr (ring<Tp>)
+            {
+                m_Unit = unit(lead);
+                if (m_Unit) m_Inverse = identity<Tp,op_mul>::get() / lead;
+
+                if (m_Unit && nb >= barrett_threshold && stable(std::span<Tp const>{m_Divisor}))
+                {
+                    // quotients are taken nb terms at a time
+                    auto const reversed = std::vector<Tp>(m_Divisor.rbegin(),m_Divisor.rend());
+                    m_Reciprocal = reciprocal(std::span<Tp const>{reversed},nb);
+
+                    auto const zero = identity<Tp,op_add>::get();
+                    m_Reversed.resize(nb,zero);
+                    m_Quotient.resize(2*nb-1,zero);
+                    m_Product.resize(2*nb-1,zero);
+                }
+            }
+        }
+
+        template <typename Tp>
+        void Reducer<Tp>::reduce(std::span<Tp> a)
+        {
+            size_t const nb = m_Divisor.size();
+            if (a.size() < nb) return;
+
+            if (!barrett()) return reduce_classical(a);
+
+            // the top nb quotient terms at a time, each block leaving nb-1 terms
+            while (a.size() >= nb)
+            {
+                size_t const nq = std::min(a.size()-nb+1,nb);
+                reduce_barrett(a.last(nq+nb-1),nq);
+                a = a.first(a.size()-nq);
+            }
+        }
+
+        template <typename Tp>
+        void Reducer<Tp>::reduce(Poly<Tp>& poly)
+        {
+            auto& coeffs = poly.coeffs();
+            coeffs.resize(poly.order()+1);
+            reduce(std::span<Tp>{coeffs});
+            trim(coeffs);
+            poly.resize(std::max<size_t>(coeffs.size(),1));
+        }
+
+        template <typename Tp>
+        void Reducer<Tp>::reduce(std::span<Poly<Tp>> batch)
+        {
+            for (auto& poly : batch)
+            {
+                reduce(poly);
+            }
+        }
+
+        template <typename Tp>
+        void Reducer<Tp>::reduce_classical(std::span<Tp> a) const
+        {
+            size_t const nb = m_Divisor.size();
+            auto const zero = identity<Tp,op_add>::get();
+
+            for (size_t i = a.size() - nb; i < a.size(); --i)
+            {
+                auto const coeff = m_Unit ? a[i+nb-1] * m_Inverse : a[i+nb-1] / m_Divisor.back();
+                for (size_t j = 0; j+1 < nb; ++j)
+                {
+                    a[i+j] -= coeff * m_Divisor[j];
+                }
+                a[i+nb-1] = m_Unit ? zero : a[i+nb-1] - coeff * m_Divisor.back();
+            }
+        }
+
+        template <typename Tp>
+        void Reducer<Tp>::reduce_barrett(std::span<Tp> a, size_t nq)
+        {
+            size_t const nb = m_Divisor.size();
+            auto const zero = identity<Tp,op_add>::get();
+
+            // rev(q) = rev(a) rev(b)^-1 modulo x^nq
+            std::reverse_copy(a.end()-nq,a.end(),m_Reversed.begin());
+            auto const rq = std::span<Tp>{m_Quotient}.first(2*nq-1);
+            multiply(rq,std::span<Tp const>{m_Reversed}.first(nq),std::span<Tp const>{m_Reciprocal}.first(nq));
+            std::reverse(rq.begin(),rq.begin()+nq);
+
+            // a - b q, of which only the low nb-1 terms survive
+            auto const bq = std::span<Tp>{m_Product}.first(nb+nq-1);
+            multiply(bq,std::span<Tp const>{m_Divisor},std::span<Tp const>{rq.first(nq)});
+            for (size_t i = 0; i+1 < nb; ++i) a[i] -= bq[i];
+            std::fill(a.begin()+(nb-1),a.end(),zero);
+        }
+
+        template <typename Tp>
+        SubproductTree<Tp>::SubproductTree(std::span<Tp const> points)
+            : m_Points(points.begin(),points.end())
+            , m_Levels(1)
+        {
+            size_t const m = m_Points.size();
+            auto const zero = identity<Tp,op_add>::get();
+            auto const one = identity<Tp,op_mul>::get();
+
+            for (size_t lo = 0; lo < std::max<size_t>(m,1); lo += leaf)
+            {
+                size_t const hi = std::min(lo+leaf,m);
+                std::vector<Tp> node{one};
+                for (size_t j = lo; j < hi; ++j)
+                {
+                    node.push_back(zero);
+                    for (size_t i = node.size()-1; i > 0; --i) node[i] = node[i-1] - m_Points[j] * node[i];
+                    node[0] = zero - m_Points[j] * node[0];
+                }
+                m_Levels[0].push_back(std::move(node));
+            }
+            while (m_Levels.back().size() > 1)
+            {
+                auto const& below = m_Levels.back();
+                std::vector<std::vector<Tp>> level;
+                for (size_t i = 0; i < below.size(); i += 2)
+                {
+                    if (i+1 == below.size()) {
+                        level.push_back(below[i]);
+                        continue;
+                    }
+                    std::vector<Tp> node(below[i].size()+below[i+1].size()-1,zero);
+                    multiply(std::span<Tp>{node},std::span<Tp const>{below[i]},std::span<Tp const>{below[i+1]});
+                    level.push_back(std::move(node));
+                }
+                m_Levels.push_back(std::move(level));
+            }
+        }
+
+        template <typename Tp>
+        void SubproductTree<Tp>::evaluate(std::span<Tp const> coeffs, std::span<Tp> values) const
+        {
+            if (m_Points.empty()) return;
+            descend(m_Levels.size()-1,0,std::vector<Tp>(coeffs.begin(),coeffs.end()),values);
+        }
+
+        template <typename Tp>
+        void SubproductTree<Tp>::descend(size_t depth, size_t index, std::vector<Tp> rem, std::span<Tp> values) const
+        {
+            // f modulo each node is f modulo its parent's remainder
+            auto const& node = m_Levels[depth][index];
+            divide(std::span<Tp>{rem},std::span<Tp const>{node},std::span<Tp>{});
+            rem.resize(std::max<size_t>(std::min(rem.size(),node.size()-1),1),identity<Tp,op_add>::get());
+
+            if (depth == 0)
+            {
+                size_t const lo = index * leaf, n = std::min(leaf,m_Points.size()-lo);
+                auto const points = std::span<Tp const>{m_Points}.subspan(lo,n);
+                return evaluate_horner(std::span<Tp const>{rem},points,values.subspan(lo,n));
+            }
+            for (size_t child = 2*index; child < std::min(2*index+2,m_Levels[depth-1].size()); ++child)
+            {
+                descend(depth-1,child,rem,values);
+            }
+        }
+
+        template <typename Tp>
+        void SubproductTree<Tp>::combine(std::span<Tp const> weights, std::span<Tp> coeffs) const
+        {
+            size_t const m = m_Points.size();
+            auto const zero = identity<Tp,op_add>::get();
+
+            // each leaf by dividing its product by each (x - x_j) in turn
+            std::vector<std::vector<Tp>> sums;
+            std::vector<Tp> quotient;
+            for (size_t index = 0; index < m_Levels[0].size(); ++index)
+            {
+                auto const& node = m_Levels[0][index];
+                size_t const lo = index * leaf, n = node.size()-1;
+
+                std::vector<Tp> sum(std::max<size_t>(n,1),zero);
+                quotient.resize(n);
+                for (size_t j = 0; j < n; ++j)
+                {
+                    auto const& x = m_Points[lo+j];
+                    quotient[n-1] = node[n];
+                    for (size_t i = n-1; i > 0; --i) quotient[i-1] = node[i] + x * quotient[i];
+                    for (size_t i = 0; i < n; ++i) sum[i] += weights[lo+j] * quotient[i];
+                }
+                sums.push_back(std::move(sum));
+            }
+
+            // then each pair as left times the right product plus right times the left
+            std::vector<Tp> product;
+            for (size_t depth = 0; depth+1 < m_Levels.size(); ++depth)
+            {
+                auto const& nodes = m_Levels[depth];
+                std::vector<std::vector<Tp>> above;
+                for (size_t i = 0; i < nodes.size(); i += 2)
+                {
+                    if (i+1 == nodes.size()) {
+                        above.push_back(std::move(sums[i]));
+                        continue;
+                    }
+                    std::vector<Tp> sum(nodes[i].size()+nodes[i+1].size()-2,zero);
+
+                    product.assign(sums[i].size()+nodes[i+1].size()-1,zero);
+                    multiply(std::span<Tp>{product},std::span<Tp const>{sums[i]},std::span<Tp const>{nodes[i+1]});
+                    for (size_t k = 0; k < std::min(product.size(),sum.size()); ++k) sum[k] += product[k];
+
+                    product.assign(sums[i+1].size()+nodes[i].size()-1,zero);
+                    multiply(std::span<Tp>{product},std::span<Tp const>{sums[i+1]},std::span<Tp const>{nodes[i]});
+                    for (size_t k = 0; k < std::min(product.size(),sum.size()); ++k) sum[k] += product[k];
+
+                    above.push_back(std::move(sum));
+                }
+                sums.swap(above);
+            }
+            std::copy_n(sums.front().begin(),m,coeffs.begin());
+        }
+
+        template <typename Tp>
+        Interpolator<Tp>::Interpolator(std::span<Tp const> points)
+            : m_Tree{points}
+            , m_Weights(points.size())
+        {
+            // the derivative of the product over all points, at each point
+            auto const& root = m_Tree.root();
+            auto const one = identity<Tp,op_mul>::get();
+
+            std::vector<Tp> derivative(std::max<size_t>(root.size()-1,1),identity<Tp,op_add>::get());
+            Tp k = one;
+            for (size_t i = 1; i < root.size(); ++i, k += one) derivative[i-1] = k * root[i];
+
+            m_Tree.evaluate(std::span<Tp const>{derivative},std::span<Tp>{m_Weights});
+            for (auto& weight : m_Weights) weight = one / weight;
+        }
+
+        template <typename Tp>
+        void Interpolator<Tp>::interpolate(std::span<Tp const> values, std::span<Tp> coeffs) const
+        {
+            if (m_Weights.empty()) return;
+
+            std::vector<Tp> weights(values.begin(),values.end());
+            for (size_t j = 0; j < weights.size(); ++j) weights[j] *= m_Weights[j];
+            m_Tree.combine(std::span<Tp const>{weights},coeffs);
+        }
+
+        template <typename Tp>
+        auto Interpolator<Tp>::interpolate(std::span<Tp const> values) const
+            -> Poly<Tp>
+        {
+            std::vector<Tp> coeffs(std::max<size_t>(m_Weights.size(),1),identity<Tp,op_add>::get());
+            interpolate(values,std::span<Tp>{coeffs});
+            return Poly<Tp>{std::move(coeffs)};
+        }
+
+        template <typename Tp>
+        auto Interpolator<Tp>::interpolate(std::span<std::vector<Tp> const> batch) const
+            -> std::vector<Poly<Tp>>
+        {
+            std::vector<Poly<Tp>> result;
+            result.reserve(batch.size());
+            for (auto const& values : batch)
+            {
+                result.push_back(interpolate(std::span<Tp const>{values}));
+            }
+            return result;
+        }
+
+    } // namespace polynomials
+
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -668,16 +1719,12 @@ namespace mpp
     auto operator*(Poly<Tp> const& poly1, Poly<Tq> const& poly2)
     {
         using Tr = op_add::result<Tp,Tq>::type;
-        std::vector<Tr> coeffs;
-        coeffs.resize(poly1.size()*poly2.size());
+        auto const a = std::span<Tp const>{poly1.coeffs()}.first(poly1.order()+1);
+        auto const b = std::span<Tq const>{poly2.coeffs()}.first(poly2.order()+1);
+
+        auto coeffs = std::vector<Tr>(a.size()+b.size()-1,identity<Tr,op_add>::get());
+        polynomials::multiply(std::span<Tr>{coeffs},a,b);
 
-        for (size_t i = 0; i <= poly1.order(); ++i)
-        {
-            for (size_t j = 0; j <= poly2.order(); ++j)
-            {
-                coeffs[i+j] += poly1[i] * poly2[j];
-            }
-        }
         auto const pred = [](auto const& coeff){ return coeff != identity<Tr,op_add>::get(); };
         auto itr = std::find_if(coeffs.rbegin(),coeffs.rend(),pred);
         coeffs.erase(itr.base(),coeffs.end());
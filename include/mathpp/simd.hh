@@ -0,0 +1,508 @@
+
+#ifndef __HH_MPP_SIMD
+#define __HH_MPP_SIMD
+
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define MPP_SIMD_X86 1
+#define MPP_SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#else
+#define MPP_SIMD_X86 0
+#endif
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * Element-wise kernels over contiguous arrays of arithmetic types, with
+     * SSE2, AVX2 and AVX-512 variants chosen once at runtime from the host
+     * CPU, and a portable scalar fallback.
+     */
+    namespace simd
+    {
+
+        enum struct isa { scalar, sse2, avx2, avx512 };
+
+        isa detect();
+
+        template <typename Tp>
+        constexpr bool supported = std::is_same<Tp,float>::value
+            || std::is_same<Tp,double>::value
+            || std::is_same<Tp,std::int32_t>::value
+            || std::is_same<Tp,std::int64_t>::value;
+
+        // arrays shorter than this are left to the compiler
+        constexpr size_t threshold = 32;
+
+        template <typename Tp>
+        void add(Tp* x, Tp const* y, size_t n);     // x[i] += y[i]
+        template <typename Tp>
+        void sub(Tp* x, Tp const* y, size_t n);     // x[i] -= y[i]
+        template <typename Tp>
+        void mul(Tp* x, Tp const& y, size_t n);     // x[i] *= y
+        template <typename Tp>
+        void div(Tp* x, Tp const& y, size_t n);     // x[i] /= y
+
+        // y[j] = c[n-1] x[j]^(n-1) + ... + c[0], by Horner's rule across points
+        template <typename Tp>
+        void horner(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m);
+
+    } // namespace simd
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace simd
+    {
+
+        enum struct op { add, sub, mul, div };
+
+        template <op Op, typename Tp>
+        inline void apply_scalar(Tp* x, Tp const* y, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                if constexpr (Op == op::add) x[i] += y[i];
+                if constexpr (Op == op::sub) x[i] -= y[i];
+            }
+        }
+
+        template <op Op, typename Tp>
+        inline void apply_scalar(Tp* x, Tp y, size_t n)
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                if constexpr (Op == op::mul) x[i] *= y;
+                if constexpr (Op == op::div) x[i] /= y;
+            }
+        }
+
+        template <typename Tp>
+        inline void horner_scalar(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            // four points at once to hide the latency of each step
+            size_t j = 0;
+            for (; j + 4 <= m; j += 4)
+            {
+                Tp r0 = c[n-1], r1 = c[n-1], r2 = c[n-1], r3 = c[n-1];
+                for (size_t i = n-1; i-- > 0; )
+                {
+                    r0 = r0 * x[j+0] + c[i];
+                    r1 = r1 * x[j+1] + c[i];
+                    r2 = r2 * x[j+2] + c[i];
+                    r3 = r3 * x[j+3] + c[i];
+                }
+                y[j+0] = r0; y[j+1] = r1; y[j+2] = r2; y[j+3] = r3;
+            }
+            for (; j < m; ++j)
+            {
+                Tp r = c[n-1];
+                for (size_t i = n-1; i-- > 0; ) r = r * x[j] + c[i];
+                y[j] = r;
+            }
+        }
+
+#if MPP_SIMD_X86
+
+        inline isa detect()
+        {
+            static isa const level = []
+            {
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f")) return isa::avx512;
+                if (__builtin_cpu_supports("avx2")) return isa::avx2;
+                if (__builtin_cpu_supports("sse2")) return isa::sse2;
+                return isa::scalar;
+            }();
+            return level;
+        }
+
+        /*
+         * Lanes describe one register width for one element type. Operations
+         * a lane cannot do natively are reported through `can`, and are left
+         * to a narrower lane or the scalar fallback.
+         */
+        template <isa Is, typename Tp>
+        struct lanes;
+
+        template <>
+        struct lanes<isa::sse2,float>
+        {
+            using reg = __m128;
+            constexpr static size_t width = 4;
+            template <op Op> constexpr static bool can = true;
+            MPP_SIMD_TARGET("sse2") static reg load(float const* p) { return _mm_loadu_ps(p); }
+            MPP_SIMD_TARGET("sse2") static void store(float* p, reg a) { _mm_storeu_ps(p,a); }
+            MPP_SIMD_TARGET("sse2") static reg broadcast(float v) { return _mm_set1_ps(v); }
+            MPP_SIMD_TARGET("sse2") static reg add(reg a, reg b) { return _mm_add_ps(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg sub(reg a, reg b) { return _mm_sub_ps(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg mul(reg a, reg b) { return _mm_mul_ps(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg div(reg a, reg b) { return _mm_div_ps(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::sse2,double>
+        {
+            using reg = __m128d;
+            constexpr static size_t width = 2;
+            template <op Op> constexpr static bool can = true;
+            MPP_SIMD_TARGET("sse2") static reg load(double const* p) { return _mm_loadu_pd(p); }
+            MPP_SIMD_TARGET("sse2") static void store(double* p, reg a) { _mm_storeu_pd(p,a); }
+            MPP_SIMD_TARGET("sse2") static reg broadcast(double v) { return _mm_set1_pd(v); }
+            MPP_SIMD_TARGET("sse2") static reg add(reg a, reg b) { return _mm_add_pd(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg sub(reg a, reg b) { return _mm_sub_pd(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg mul(reg a, reg b) { return _mm_mul_pd(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg div(reg a, reg b) { return _mm_div_pd(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::sse2,std::int32_t>
+        {
+            using reg = __m128i;
+            constexpr static size_t width = 4;
+            template <op Op> constexpr static bool can = Op == op::add || Op == op::sub;
+            MPP_SIMD_TARGET("sse2") static reg load(std::int32_t const* p) { return _mm_loadu_si128((__m128i const*)p); }
+            MPP_SIMD_TARGET("sse2") static void store(std::int32_t* p, reg a) { _mm_storeu_si128((__m128i*)p,a); }
+            MPP_SIMD_TARGET("sse2") static reg broadcast(std::int32_t v) { return _mm_set1_epi32(v); }
+            MPP_SIMD_TARGET("sse2") static reg add(reg a, reg b) { return _mm_add_epi32(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg sub(reg a, reg b) { return _mm_sub_epi32(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::sse2,std::int64_t>
+        {
+            using reg = __m128i;
+            constexpr static size_t width = 2;
+            template <op Op> constexpr static bool can = Op == op::add || Op == op::sub;
+            MPP_SIMD_TARGET("sse2") static reg load(std::int64_t const* p) { return _mm_loadu_si128((__m128i const*)p); }
+            MPP_SIMD_TARGET("sse2") static void store(std::int64_t* p, reg a) { _mm_storeu_si128((__m128i*)p,a); }
+            MPP_SIMD_TARGET("sse2") static reg broadcast(std::int64_t v) { return _mm_set1_epi64x(v); }
+            MPP_SIMD_TARGET("sse2") static reg add(reg a, reg b) { return _mm_add_epi64(a,b); }
+            MPP_SIMD_TARGET("sse2") static reg sub(reg a, reg b) { return _mm_sub_epi64(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx2,float>
+        {
+            using reg = __m256;
+            constexpr static size_t width = 8;
+            template <op Op> constexpr static bool can = true;
+            MPP_SIMD_TARGET("avx2") static reg load(float const* p) { return _mm256_loadu_ps(p); }
+            MPP_SIMD_TARGET("avx2") static void store(float* p, reg a) { _mm256_storeu_ps(p,a); }
+            MPP_SIMD_TARGET("avx2") static reg broadcast(float v) { return _mm256_set1_ps(v); }
+            MPP_SIMD_TARGET("avx2") static reg add(reg a, reg b) { return _mm256_add_ps(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg sub(reg a, reg b) { return _mm256_sub_ps(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg mul(reg a, reg b) { return _mm256_mul_ps(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg div(reg a, reg b) { return _mm256_div_ps(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx2,double>
+        {
+            using reg = __m256d;
+            constexpr static size_t width = 4;
+            template <op Op> constexpr static bool can = true;
+            MPP_SIMD_TARGET("avx2") static reg load(double const* p) { return _mm256_loadu_pd(p); }
+            MPP_SIMD_TARGET("avx2") static void store(double* p, reg a) { _mm256_storeu_pd(p,a); }
+            MPP_SIMD_TARGET("avx2") static reg broadcast(double v) { return _mm256_set1_pd(v); }
+            MPP_SIMD_TARGET("avx2") static reg add(reg a, reg b) { return _mm256_add_pd(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg sub(reg a, reg b) { return _mm256_sub_pd(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg mul(reg a, reg b) { return _mm256_mul_pd(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg div(reg a, reg b) { return _mm256_div_pd(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx2,std::int32_t>
+        {
+            using reg = __m256i;
+            constexpr static size_t width = 8;
+            template <op Op> constexpr static bool can = Op != op::div;
+            MPP_SIMD_TARGET("avx2") static reg load(std::int32_t const* p) { return _mm256_loadu_si256((__m256i const*)p); }
+            MPP_SIMD_TARGET("avx2") static void store(std::int32_t* p, reg a) { _mm256_storeu_si256((__m256i*)p,a); }
+            MPP_SIMD_TARGET("avx2") static reg broadcast(std::int32_t v) { return _mm256_set1_epi32(v); }
+            MPP_SIMD_TARGET("avx2") static reg add(reg a, reg b) { return _mm256_add_epi32(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg sub(reg a, reg b) { return _mm256_sub_epi32(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg mul(reg a, reg b) { return _mm256_mullo_epi32(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx2,std::int64_t>
+        {
+            using reg = __m256i;
+            constexpr static size_t width = 4;
+            template <op Op> constexpr static bool can = Op == op::add || Op == op::sub;
+            MPP_SIMD_TARGET("avx2") static reg load(std::int64_t const* p) { return _mm256_loadu_si256((__m256i const*)p); }
+            MPP_SIMD_TARGET("avx2") static void store(std::int64_t* p, reg a) { _mm256_storeu_si256((__m256i*)p,a); }
+            MPP_SIMD_TARGET("avx2") static reg broadcast(std::int64_t v) { return _mm256_set1_epi64x(v); }
+            MPP_SIMD_TARGET("avx2") static reg add(reg a, reg b) { return _mm256_add_epi64(a,b); }
+            MPP_SIMD_TARGET("avx2") static reg sub(reg a, reg b) { return _mm256_sub_epi64(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx512,float>
+        {
+            using reg = __m512;
+            constexpr static size_t width = 16;
+            template <op Op> constexpr static bool can = true;
+            MPP_SIMD_TARGET("avx512f") static reg load(float const* p) { return _mm512_loadu_ps(p); }
+            MPP_SIMD_TARGET("avx512f") static void store(float* p, reg a) { _mm512_storeu_ps(p,a); }
+            MPP_SIMD_TARGET("avx512f") static reg broadcast(float v) { return _mm512_set1_ps(v); }
+            MPP_SIMD_TARGET("avx512f") static reg add(reg a, reg b) { return _mm512_add_ps(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg sub(reg a, reg b) { return _mm512_sub_ps(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg mul(reg a, reg b) { return _mm512_mul_ps(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg div(reg a, reg b) { return _mm512_div_ps(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx512,double>
+        {
+            using reg = __m512d;
+            constexpr static size_t width = 8;
+            template <op Op> constexpr static bool can = true;
+            MPP_SIMD_TARGET("avx512f") static reg load(double const* p) { return _mm512_loadu_pd(p); }
+            MPP_SIMD_TARGET("avx512f") static void store(double* p, reg a) { _mm512_storeu_pd(p,a); }
+            MPP_SIMD_TARGET("avx512f") static reg broadcast(double v) { return _mm512_set1_pd(v); }
+            MPP_SIMD_TARGET("avx512f") static reg add(reg a, reg b) { return _mm512_add_pd(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg sub(reg a, reg b) { return _mm512_sub_pd(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg mul(reg a, reg b) { return _mm512_mul_pd(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg div(reg a, reg b) { return _mm512_div_pd(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx512,std::int32_t>
+        {
+            using reg = __m512i;
+            constexpr static size_t width = 16;
+            template <op Op> constexpr static bool can = Op != op::div;
+            MPP_SIMD_TARGET("avx512f") static reg load(std::int32_t const* p) { return _mm512_loadu_si512(p); }
+            MPP_SIMD_TARGET("avx512f") static void store(std::int32_t* p, reg a) { _mm512_storeu_si512(p,a); }
+            MPP_SIMD_TARGET("avx512f") static reg broadcast(std::int32_t v) { return _mm512_set1_epi32(v); }
+            MPP_SIMD_TARGET("avx512f") static reg add(reg a, reg b) { return _mm512_add_epi32(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg sub(reg a, reg b) { return _mm512_sub_epi32(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg mul(reg a, reg b) { return _mm512_mullo_epi32(a,b); }
+        };
+
+        template <>
+        struct lanes<isa::avx512,std::int64_t>
+        {
+            using reg = __m512i;
+            constexpr static size_t width = 8;
+            template <op Op> constexpr static bool can = Op == op::add || Op == op::sub;
+            MPP_SIMD_TARGET("avx512f") static reg load(std::int64_t const* p) { return _mm512_loadu_si512(p); }
+            MPP_SIMD_TARGET("avx512f") static void store(std::int64_t* p, reg a) { _mm512_storeu_si512(p,a); }
+            MPP_SIMD_TARGET("avx512f") static reg broadcast(std::int64_t v) { return _mm512_set1_epi64(v); }
+            MPP_SIMD_TARGET("avx512f") static reg add(reg a, reg b) { return _mm512_add_epi64(a,b); }
+            MPP_SIMD_TARGET("avx512f") static reg sub(reg a, reg b) { return _mm512_sub_epi64(a,b); }
+        };
+
+        template <typename Tq>
+        inline Tq advance(Tq y, size_t i)
+        {
+            if constexpr (std::is_pointer<Tq>::value) {
+                return y + i;
+            } else {
+                return y;
+            }
+        }
+
+        /*
+         * The loops are written once over the lanes, and always inlined into
+         * a one-line entry point per instruction set, as the target cannot be
+         * a template parameter. Inlined there, the lane operations are
+         * compiled for that instruction set. Never emitted on their own, the
+         * loops pass no vectors across calls, whatever -Wpsabi reports.
+         */
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+
+        template <op Op, typename L, typename Tp, typename Tq>
+        [[gnu::always_inline]] inline void apply_lanes(Tp* x, Tq y, size_t n)
+        {
+            size_t i = 0;
+            for (; i + L::width <= n; i += L::width)
+            {
+                auto const a = L::load(x+i);
+                if constexpr (Op == op::add) L::store(x+i,L::add(a,L::load(y+i)));
+                if constexpr (Op == op::sub) L::store(x+i,L::sub(a,L::load(y+i)));
+                if constexpr (Op == op::mul) L::store(x+i,L::mul(a,L::broadcast(y)));
+                if constexpr (Op == op::div) L::store(x+i,L::div(a,L::broadcast(y)));
+            }
+            apply_scalar<Op>(x+i,advance(y,i),n-i);
+        }
+
+        template <typename L, typename Tp>
+        [[gnu::always_inline]] inline void horner_lanes(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            constexpr size_t W = L::width;
+            size_t j = 0;
+            for (; j + 4*W <= m; j += 4*W)
+            {
+                auto const x0 = L::load(x+j), x1 = L::load(x+j+W), x2 = L::load(x+j+2*W), x3 = L::load(x+j+3*W);
+                auto r0 = L::broadcast(c[n-1]), r1 = r0, r2 = r0, r3 = r0;
+                for (size_t i = n-1; i-- > 0; )
+                {
+                    auto const ci = L::broadcast(c[i]);
+                    r0 = L::add(L::mul(r0,x0),ci);
+                    r1 = L::add(L::mul(r1,x1),ci);
+                    r2 = L::add(L::mul(r2,x2),ci);
+                    r3 = L::add(L::mul(r3,x3),ci);
+                }
+                L::store(y+j,r0); L::store(y+j+W,r1); L::store(y+j+2*W,r2); L::store(y+j+3*W,r3);
+            }
+            for (; j + W <= m; j += W)
+            {
+                auto const x0 = L::load(x+j);
+                auto r0 = L::broadcast(c[n-1]);
+                for (size_t i = n-1; i-- > 0; ) r0 = L::add(L::mul(r0,x0),L::broadcast(c[i]));
+                L::store(y+j,r0);
+            }
+            horner_scalar(c,n,x+j,y+j,m-j);
+        }
+
+#pragma GCC diagnostic pop
+
+        template <op Op, typename Tp, typename Tq>
+        MPP_SIMD_TARGET("sse2") void apply_sse2(Tp* x, Tq y, size_t n)
+        {
+            apply_lanes<Op,lanes<isa::sse2,Tp>>(x,y,n);
+        }
+
+        template <op Op, typename Tp, typename Tq>
+        MPP_SIMD_TARGET("avx2") void apply_avx2(Tp* x, Tq y, size_t n)
+        {
+            apply_lanes<Op,lanes<isa::avx2,Tp>>(x,y,n);
+        }
+
+        template <op Op, typename Tp, typename Tq>
+        MPP_SIMD_TARGET("avx512f") void apply_avx512(Tp* x, Tq y, size_t n)
+        {
+            apply_lanes<Op,lanes<isa::avx512,Tp>>(x,y,n);
+        }
+
+        template <op Op, typename Tp, typename Tq>
+        inline void apply(Tp* x, Tq y, size_t n)
+        {
+            isa const level = detect();
+
+            if constexpr (lanes<isa::avx512,Tp>::template can<Op>) {
+                if (level >= isa::avx512) return apply_avx512<Op>(x,y,n);
+            }
+            if constexpr (lanes<isa::avx2,Tp>::template can<Op>) {
+                if (level >= isa::avx2) return apply_avx2<Op>(x,y,n);
+            }
+            if constexpr (lanes<isa::sse2,Tp>::template can<Op>) {
+                if (level >= isa::sse2) return apply_sse2<Op>(x,y,n);
+            }
+            apply_scalar<Op>(x,y,n);
+        }
+
+        template <typename Tp>
+        MPP_SIMD_TARGET("sse2") void horner_sse2(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            horner_lanes<lanes<isa::sse2,Tp>>(c,n,x,y,m);
+        }
+
+        template <typename Tp>
+        MPP_SIMD_TARGET("avx2") void horner_avx2(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            horner_lanes<lanes<isa::avx2,Tp>>(c,n,x,y,m);
+        }
+
+        template <typename Tp>
+        MPP_SIMD_TARGET("avx512f") void horner_avx512(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            horner_lanes<lanes<isa::avx512,Tp>>(c,n,x,y,m);
+        }
+
+        template <typename Tp>
+        inline void horner_dispatch(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            isa const level = detect();
+
+            if constexpr (lanes<isa::avx512,Tp>::template can<op::mul>) {
+                if (level >= isa::avx512) return horner_avx512(c,n,x,y,m);
+            }
+            if constexpr (lanes<isa::avx2,Tp>::template can<op::mul>) {
+                if (level >= isa::avx2) return horner_avx2(c,n,x,y,m);
+            }
+            if constexpr (lanes<isa::sse2,Tp>::template can<op::mul>) {
+                if (level >= isa::sse2) return horner_sse2(c,n,x,y,m);
+            }
+            horner_scalar(c,n,x,y,m);
+        }
+
+#else
+
+        inline isa detect()
+        {
+            return isa::scalar;
+        }
+
+        template <op Op, typename Tp, typename Tq>
+        inline void apply(Tp* x, Tq y, size_t n)
+        {
+            apply_scalar<Op>(x,y,n);
+        }
+
+        template <typename Tp>
+        inline void horner_dispatch(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            horner_scalar(c,n,x,y,m);
+        }
+
+#endif
+
+        template <typename Tp>
+        void add(Tp* x, Tp const* y, size_t n)
+        {
+            apply<op::add,Tp,Tp const*>(x,y,n);
+        }
+
+        template <typename Tp>
+        void sub(Tp* x, Tp const* y, size_t n)
+        {
+            apply<op::sub,Tp,Tp const*>(x,y,n);
+        }
+
+        template <typename Tp>
+        void mul(Tp* x, Tp const& y, size_t n)
+        {
+            apply<op::mul,Tp,Tp>(x,y,n);
+        }
+
+        template <typename Tp>
+        void div(Tp* x, Tp const& y, size_t n)
+        {
+            apply<op::div,Tp,Tp>(x,y,n);
+        }
+
+        template <typename Tp>
+        void horner(Tp const* c, size_t n, Tp const* x, Tp* y, size_t m)
+        {
+            if (n == 0) {
+                std::fill_n(y,m,Tp{});
+            } else {
+                horner_dispatch(c,n,x,y,m);
+            }
+        }
+
+    } // namespace simd
+
+} // namespace mpp
+
+#endif /* __HH_MPP_SIMD */
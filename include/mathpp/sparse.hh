@@ -0,0 +1,541 @@
+
+#ifndef __HH_MPP_SPARSE
+#define __HH_MPP_SPARSE
+
+#include "mathpp/mathpp.hh"
+#include "mathpp/poly.hh"
+
+#include <map>
+#include <span>
+#include <queue>
+#include <tuple>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <initializer_list>
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * A polynomial of few terms, stored as (exponent, coefficient) pairs in
+     * increasing order of exponent without zero coefficients, so that its
+     * memory and the cost of its operations grow with its terms rather than
+     * its degree. It converts explicitly to and from the dense `Poly`.
+     */
+    template <typename Tp>
+    class SparsePoly
+    {
+    public:
+        using term_type = std::pair<size_t,Tp>;
+
+        explicit SparsePoly();
+
+        SparsePoly(std::initializer_list<term_type>);
+        SparsePoly(std::vector<term_type>);
+
+        explicit SparsePoly(Poly<Tp> const&);
+        explicit operator Poly<Tp>() const;
+
+        void swap(SparsePoly<Tp>&);
+
+    public:
+        auto terms() const -> std::vector<term_type> const& { return m_Terms; }
+        auto size() const -> size_t { return m_Terms.size(); }
+        auto order() const -> size_t { return m_Terms.empty() ? 0 : m_Terms.back().first; }
+        auto back() const -> Tp;
+
+        // the coefficient of x^exponent, zero where there is no term
+        auto operator[](size_t exponent) const -> Tp;
+        auto operator()(Tp const& x) const -> Tp;
+
+        SparsePoly<Tp>& operator<<=(size_t);
+        SparsePoly<Tp>& operator>>=(size_t);
+
+        SparsePoly<Tp>& operator*=(Tp const&);
+
+        SparsePoly<Tp>& operator+=(SparsePoly<Tp> const&);
+        SparsePoly<Tp>& operator-=(SparsePoly<Tp> const&);
+        SparsePoly<Tp>& operator*=(SparsePoly<Tp> const&);
+        SparsePoly<Tp>& operator%=(SparsePoly<Tp> const&);
+
+    private:
+        void normalise();
+
+    private:
+        std::vector<term_type> m_Terms{};
+    };
+
+    namespace polynomials
+    {
+
+        /*
+         * Products of sparse terms by merging, on a heap, one stream of
+         * products per term of the shorter operand, so that the terms of the
+         * product arrive in order and are summed as they do.
+         */
+        template <typename Tp>
+        auto multiply_sparse(std::span<std::pair<size_t,Tp> const> a, std::span<std::pair<size_t,Tp> const> b)
+            -> std::vector<std::pair<size_t,Tp>>;
+
+        // whether a dense polynomial has few enough terms to be kept sparse
+        template <typename Tp>
+        bool is_sparse(Poly<Tp> const&);
+
+    } // namespace polynomials
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// MathPP Specialisations
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    // identity
+
+    template <typename Tp>
+    struct identity<SparsePoly<Tp>,op_add>
+    {
+        constexpr static tristate has()
+        {
+            return identity<Tp,op_add>::has();
+        }
+        constexpr static SparsePoly<Tp> get()
+        {
+            return SparsePoly<Tp>{};
+        }
+        constexpr static SparsePoly<Tp>& make(SparsePoly<Tp>& poly)
+        {
+            return poly = get();
+        }
+    };
+
+    template <typename Tp>
+    struct identity<SparsePoly<Tp>,op_mul>
+    {
+        constexpr static tristate has()
+        {
+            return identity<Tp,op_mul>::has();
+        }
+        constexpr static SparsePoly<Tp> get()
+        {
+            return SparsePoly<Tp>{{0,identity<Tp,op_mul>::get()}};
+        }
+        constexpr static SparsePoly<Tp>& make(SparsePoly<Tp>& poly)
+        {
+            return poly = get();
+        }
+    };
+
+    // division
+
+    template <typename Tp>
+    struct division<SparsePoly<Tp>,SparsePoly<Tp>>
+    {
+        constexpr static tristate has()
+        {
+            return logic::all;
+        }
+        constexpr static bool can(SparsePoly<Tp> const&, SparsePoly<Tp> const& poly2)
+        {
+            return poly2.size() != 0;
+        }
+        static auto get(SparsePoly<Tp> const& poly1, SparsePoly<Tp> const& poly2)
+        {
+            if (poly2.size() == 0)
+            {
+                throw std::domain_error("mpp::polynomials::divide");
+            }
+            auto const zero = identity<Tp,op_add>::get();
+            auto const [degree,lead] = poly2.terms().back();
+            bool const exact = polynomials::unit(lead);
+
+            // the remainder by exponent, cancelled from the top a term at a time
+            auto remainder = std::map<size_t,Tp>(poly1.terms().begin(),poly1.terms().end());
+            std::vector<std::pair<size_t,Tp>> quotient;
+
+            auto itr = remainder.end();
+            while (itr != remainder.begin())
+            {
+                --itr;
+                auto const [exponent,value] = *itr;
+                if (exponent < degree) break;
+
+                auto const coeff = value / lead;
+                if (coeff != zero)
+                {
+                    quotient.emplace_back(exponent-degree,coeff);
+                    for (auto const& [power,term] : poly2.terms())
+                    {
+                        auto const at = remainder.try_emplace(exponent-degree+power,zero).first;
+                        at->second -= coeff * term;
+                        if (at->second == zero && power != degree) remainder.erase(at);
+                    }
+                }
+                // terms a unit leading coefficient cannot cancel are left behind
+                itr = remainder.find(exponent);
+                if (exact || itr->second == zero) itr = remainder.erase(itr);
+            }
+
+            std::reverse(quotient.begin(),quotient.end());
+            auto const terms = std::vector<std::pair<size_t,Tp>>(remainder.begin(),remainder.end());
+            return std::make_tuple(SparsePoly<Tp>{std::move(terms)},SparsePoly<Tp>{std::move(quotient)});
+        }
+    };
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Namespace Functions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace polynomials
+    {
+
+        template <typename Tp>
+        auto multiply_sparse(std::span<std::pair<size_t,Tp> const> a, std::span<std::pair<size_t,Tp> const> b)
+            -> std::vector<std::pair<size_t,Tp>>
+        {
+            if (a.empty() || b.empty()) return {};
+            if (a.size() > b.size()) std::swap(a,b);
+
+            // (exponent, i, j) for the next product a_i b_j of every stream
+            using entry = std::tuple<size_t,size_t,size_t>;
+            std::priority_queue<entry,std::vector<entry>,std::greater<entry>> heap;
+            for (size_t i = 0; i < a.size(); ++i)
+            {
+                heap.emplace(a[i].first+b[0].first,i,0);
+            }
+
+            auto const zero = identity<Tp,op_add>::get();
+            std::vector<std::pair<size_t,Tp>> result;
+            while (!heap.empty())
+            {
+                auto const [exponent,i,j] = heap.top();
+                heap.pop();
+
+                auto const product = a[i].second * b[j].second;
+                if (!result.empty() && result.back().first == exponent) {
+                    result.back().second += product;
+                } else {
+                    if (!result.empty() && result.back().second == zero) result.pop_back();
+                    result.emplace_back(exponent,product);
+                }
+                if (j+1 < b.size()) heap.emplace(a[i].first+b[j+1].first,i,j+1);
+            }
+            if (!result.empty() && result.back().second == zero) result.pop_back();
+            return result;
+        }
+
+        template <typename Tp>
+        bool is_sparse(Poly<Tp> const& poly)
+        {
+            auto const& coeffs = poly.coeffs();
+            size_t const count = coeffs.size() - std::count(coeffs.begin(),coeffs.end(),identity<Tp,op_add>::get());
+            return count * sparse_ratio <= poly.order() + 1;
+        }
+
+    } // namespace polynomials
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp>
+    SparsePoly<Tp>::SparsePoly()
+    {
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>::SparsePoly(std::initializer_list<term_type> terms)
+        : m_Terms{terms}
+    {
+        normalise();
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>::SparsePoly(std::vector<term_type> terms)
+        : m_Terms{std::move(terms)}
+    {
+        normalise();
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>::SparsePoly(Poly<Tp> const& poly)
+    {
+        auto const zero = identity<Tp,op_add>::get();
+        for (size_t i = 0; i <= poly.order(); ++i)
+        {
+            if (poly[i] != zero) m_Terms.emplace_back(i,poly[i]);
+        }
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>::operator Poly<Tp>() const
+    {
+        auto coeffs = std::vector<Tp>(order()+1,identity<Tp,op_add>::get());
+        for (auto const& [exponent,coeff] : m_Terms)
+        {
+            coeffs[exponent] = coeff;
+        }
+        return Poly<Tp>{std::move(coeffs)};
+    }
+
+    template <typename Tp>
+    void SparsePoly<Tp>::normalise()
+    {
+        auto const zero = identity<Tp,op_add>::get();
+        std::stable_sort(m_Terms.begin(),m_Terms.end(),[](auto const& a, auto const& b){ return a.first < b.first; });
+
+        // like terms summed, and zero terms dropped
+        size_t count = 0;
+        for (size_t i = 0; i < m_Terms.size(); ++i)
+        {
+            if (count > 0 && m_Terms[count-1].first == m_Terms[i].first) {
+                m_Terms[count-1].second += m_Terms[i].second;
+            } else {
+                if (count > 0 && m_Terms[count-1].second == zero) --count;
+                m_Terms[count++] = m_Terms[i];
+            }
+        }
+        if (count > 0 && m_Terms[count-1].second == zero) --count;
+        m_Terms.resize(count);
+    }
+
+    template <typename Tp>
+    void SparsePoly<Tp>::swap(SparsePoly<Tp>& other)
+    {
+        std::swap(m_Terms,other.m_Terms);
+    }
+
+    template <typename Tp>
+    auto SparsePoly<Tp>::back() const
+        -> Tp
+    {
+        return m_Terms.empty() ? identity<Tp,op_add>::get() : m_Terms.back().second;
+    }
+
+    template <typename Tp>
+    auto SparsePoly<Tp>::operator[](size_t exponent) const
+        -> Tp
+    {
+        auto const itr = std::lower_bound(m_Terms.begin(),m_Terms.end(),exponent,
+            [](auto const& term, size_t e){ return term.first < e; });
+        return (itr != m_Terms.end() && itr->first == exponent) ? itr->second : identity<Tp,op_add>::get();
+    }
+
+    template <typename Tp>
+    auto SparsePoly<Tp>::operator()(Tp const& x) const
+        -> Tp
+    {
+        auto const power = [&](size_t n)
+        {
+            Tp result = identity<Tp,op_mul>::get(), base = x;
+            for (; n; n >>= 1, base = base * base)
+            {
+                if (n & 1) result = result * base;
+            }
+            return result;
+        };
+
+        // Horner's rule, stepping over the gaps between terms by squaring
+        Tp result = identity<Tp,op_add>::get();
+        size_t above = order();
+        for (auto itr = m_Terms.rbegin(); itr != m_Terms.rend(); ++itr)
+        {
+            result = result * power(above - itr->first) + itr->second;
+            above = itr->first;
+        }
+        return result * power(above);
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>& SparsePoly<Tp>::operator<<=(size_t n)
+    {
+        for (auto& term : m_Terms)
+        {
+            term.first += n;
+        }
+        return *this;
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>& SparsePoly<Tp>::operator>>=(size_t n)
+    {
+        auto const itr = std::lower_bound(m_Terms.begin(),m_Terms.end(),n,
+            [](auto const& term, size_t e){ return term.first < e; });
+        m_Terms.erase(m_Terms.begin(),itr);
+        for (auto& term : m_Terms)
+        {
+            term.first -= n;
+        }
+        return *this;
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>& SparsePoly<Tp>::operator*=(Tp const& c)
+    {
+        for (auto& term : m_Terms)
+        {
+            term.second *= c;
+        }
+        normalise();
+        return *this;
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>& SparsePoly<Tp>::operator+=(SparsePoly<Tp> const& other)
+    {
+        std::vector<term_type> terms;
+        terms.reserve(size()+other.size());
+        std::merge(m_Terms.begin(),m_Terms.end(),other.m_Terms.begin(),other.m_Terms.end(),std::back_inserter(terms),
+            [](auto const& a, auto const& b){ return a.first < b.first; });
+        m_Terms.swap(terms);
+        normalise();
+        return *this;
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>& SparsePoly<Tp>::operator-=(SparsePoly<Tp> const& other)
+    {
+        auto negated = other;
+        for (auto& term : negated.m_Terms)
+        {
+            term.second = identity<Tp,op_add>::get() - term.second;
+        }
+        return *this += negated;
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>& SparsePoly<Tp>::operator*=(SparsePoly<Tp> const& other)
+    {
+        m_Terms = polynomials::multiply_sparse(std::span<term_type const>{m_Terms},std::span<term_type const>{other.m_Terms});
+        return *this;
+    }
+
+    template <typename Tp>
+    SparsePoly<Tp>& SparsePoly<Tp>::operator%=(SparsePoly<Tp> const& other)
+    {
+        *this = std::get<0>(division<SparsePoly<Tp>,SparsePoly<Tp>>::get(*this,other));
+        return *this;
+    }
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Non-Member Extensions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp>
+    bool operator==(SparsePoly<Tp> const& poly1, SparsePoly<Tp> const& poly2)
+    {
+        return poly1.terms() == poly2.terms();
+    }
+
+    template <typename Tp>
+    auto operator<<(SparsePoly<Tp> poly, size_t n)
+    {
+        return poly <<= n;
+    }
+
+    template <typename Tp>
+    auto operator>>(SparsePoly<Tp> poly, size_t n)
+    {
+        return poly >>= n;
+    }
+
+    template <typename Tp>
+    auto operator+(SparsePoly<Tp> poly1, SparsePoly<Tp> const& poly2)
+    {
+        return poly1 += poly2;
+    }
+
+    template <typename Tp>
+    auto operator-(SparsePoly<Tp> poly1, SparsePoly<Tp> const& poly2)
+    {
+        return poly1 -= poly2;
+    }
+
+    template <typename Tp>
+    auto operator*(SparsePoly<Tp> const& poly1, SparsePoly<Tp> const& poly2)
+    {
+        using term_type = typename SparsePoly<Tp>::term_type;
+        auto const a = std::span<term_type const>{poly1.terms()};
+        auto const b = std::span<term_type const>{poly2.terms()};
+        return SparsePoly<Tp>{polynomials::multiply_sparse(a,b)};
+    }
+
+    template <typename Tp>
+    auto operator*(SparsePoly<Tp> poly, Tp const& c)
+    {
+        return poly *= c;
+    }
+
+    template <typename Tp>
+    auto operator*(Tp const& c, SparsePoly<Tp> poly)
+    {
+        return poly *= c;
+    }
+
+    template <typename Tp>
+    auto operator%(SparsePoly<Tp> const& poly1, SparsePoly<Tp> const& poly2)
+    {
+        return std::get<0>(division<SparsePoly<Tp>,SparsePoly<Tp>>::get(poly1,poly2));
+    }
+
+    // a dense dividend by a sparse divisor, touching only the divisor's terms
+    template <typename Tp>
+    auto operator%(Poly<Tp> const& poly1, SparsePoly<Tp> const& poly2)
+    {
+        if (poly2.size() == 0)
+        {
+            throw std::domain_error("mpp::polynomials::divide");
+        }
+        using term_type = typename SparsePoly<Tp>::term_type;
+        auto coeffs = std::vector<Tp>(poly1.coeffs().begin(),poly1.coeffs().begin()+poly1.order()+1);
+
+        if (coeffs.size() > poly2.order())
+        {
+            polynomials::divide_sparse(std::span<Tp>{coeffs},std::span<term_type const>{poly2.terms()},std::span<Tp>{});
+        }
+        polynomials::trim(coeffs);
+        return Poly<Tp>{std::move(coeffs)};
+    }
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Standard Overloads
+/* ************************************************************************** */
+
+namespace std
+{
+
+    template <typename Tp>
+    void swap(mpp::SparsePoly<Tp>& poly1, mpp::SparsePoly<Tp>& poly2)
+    {
+        poly1.swap(poly2);
+    }
+
+} // namespace std
+
+#endif /* __HH_MPP_SPARSE */
@@ -0,0 +1,244 @@
+
+#ifndef __HH_MPP_STORAGE
+#define __HH_MPP_STORAGE
+
+#include <new>
+#include <array>
+#include <utility>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+/*
+ * Storages holding more than this many bytes are placed on the heap, so that
+ * very large compile-time dimensions do not overflow the stack.
+ */
+#ifndef MPP_STORAGE_INLINE_BYTES
+#define MPP_STORAGE_INLINE_BYTES 4096
+#endif
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, size_t Nm>
+    constexpr size_t storage_alignment();
+
+    template <typename Tp, size_t Nm>
+    constexpr bool storage_inline();
+
+    template <typename Tp, size_t Nm, bool In = storage_inline<Tp,Nm>()>
+    class Storage;
+
+    /*
+     * Fixed-size storage kept inline within the owning object. Trivially
+     * copyable whenever `Tp` is, and usable in constant expressions.
+     */
+    template <typename Tp, size_t Nm>
+    class Storage<Tp,Nm,true>
+    {
+    public:
+        constexpr Storage() : m_Elements{} {}
+        constexpr explicit Storage(Tp const&);
+
+        template <typename... Args>
+        constexpr explicit Storage(std::in_place_t, Args&&...);
+
+    public:
+        constexpr auto array() const -> std::array<Tp,Nm> const& { return m_Elements; }
+        constexpr auto array() -> std::array<Tp,Nm>& { return m_Elements; }
+        constexpr auto data() const -> Tp const* { return m_Elements.data(); }
+        constexpr auto data() -> Tp* { return m_Elements.data(); }
+
+        constexpr auto operator[](size_t i) const -> Tp const& { return m_Elements[i]; }
+        constexpr auto operator[](size_t i) -> Tp& { return m_Elements[i]; }
+
+    private:
+        alignas(storage_alignment<Tp,Nm>()) std::array<Tp,Nm> m_Elements;
+    };
+
+    /*
+     * Fixed-size storage kept in a single aligned heap block. Every storage
+     * owns a block; a moved-from storage holds value-initialised elements
+     * after construction, or the target's old elements after assignment.
+     */
+    template <typename Tp, size_t Nm>
+    class Storage<Tp,Nm,false>
+    {
+    public:
+        constexpr Storage();
+        constexpr explicit Storage(Tp const&);
+        constexpr ~Storage();
+
+        template <typename... Args>
+        constexpr explicit Storage(std::in_place_t, Args&&...);
+
+        constexpr Storage(Storage const&);
+        constexpr Storage(Storage&&);
+        constexpr Storage& operator=(Storage const&);
+        constexpr Storage& operator=(Storage&&) noexcept;
+
+    public:
+        constexpr auto array() const -> std::array<Tp,Nm> const& { return m_Block->elements; }
+        constexpr auto array() -> std::array<Tp,Nm>& { return m_Block->elements; }
+        constexpr auto data() const -> Tp const* { return m_Block->elements.data(); }
+        constexpr auto data() -> Tp* { return m_Block->elements.data(); }
+
+        constexpr auto operator[](size_t i) const -> Tp const& { return m_Block->elements[i]; }
+        constexpr auto operator[](size_t i) -> Tp& { return m_Block->elements[i]; }
+
+    private:
+        struct alignas(storage_alignment<Tp,Nm>()) Block
+        {
+            std::array<Tp,Nm> elements;
+        };
+        Block* m_Block;
+    };
+
+    /*
+     * An allocator aligning every block to `Al` bytes, so that heap storage
+     * of runtime size starts on a full vector register boundary.
+     */
+    template <typename Tp, size_t Al = 64>
+    class AlignedAllocator
+    {
+    public:
+        using value_type = Tp;
+
+        template <typename Tq>
+        struct rebind { using other = AlignedAllocator<Tq,Al>; };
+
+        AlignedAllocator() noexcept = default;
+
+        template <typename Tq>
+        AlignedAllocator(AlignedAllocator<Tq,Al> const&) noexcept {}
+
+    public:
+        Tp* allocate(size_t);
+        void deallocate(Tp*, size_t) noexcept;
+
+        constexpr size_t max_size() const noexcept { return std::numeric_limits<size_t>::max() / sizeof(Tp); }
+
+        template <typename Tq>
+        bool operator==(AlignedAllocator<Tq,Al> const&) const noexcept { return true; }
+    };
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, size_t Nm>
+    constexpr size_t storage_alignment()
+    {
+        // the widest vector alignment that divides the storage, so that
+        // aligning never introduces padding
+        size_t const bytes = sizeof(Tp) * Nm;
+
+        for (size_t align : {64, 32, 16})
+        {
+            if (align > alignof(Tp) && bytes % align == 0) return align;
+        }
+        return alignof(Tp);
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr bool storage_inline()
+    {
+        return sizeof(Tp) * Nm <= MPP_STORAGE_INLINE_BYTES;
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr Storage<Tp,Nm,true>::Storage(Tp const& value)
+        : m_Elements{}
+    {
+        m_Elements.fill(value);
+    }
+
+    template <typename Tp, size_t Nm>
+    template <typename... Args>
+    constexpr Storage<Tp,Nm,true>::Storage(std::in_place_t, Args&&... args)
+        : m_Elements{std::forward<Args>(args)...}
+    {
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr Storage<Tp,Nm,false>::Storage()
+        : m_Block{new Block{}}
+    {
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr Storage<Tp,Nm,false>::Storage(Tp const& value)
+        : m_Block{new Block{}}
+    {
+        m_Block->elements.fill(value);
+    }
+
+    template <typename Tp, size_t Nm>
+    template <typename... Args>
+    constexpr Storage<Tp,Nm,false>::Storage(std::in_place_t, Args&&... args)
+        : m_Block{new Block{{std::forward<Args>(args)...}}}
+    {
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr Storage<Tp,Nm,false>::~Storage()
+    {
+        delete m_Block;
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr Storage<Tp,Nm,false>::Storage(Storage const& other)
+        : m_Block{new Block{*other.m_Block}}
+    {
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr Storage<Tp,Nm,false>::Storage(Storage&& other)
+        : m_Block{std::exchange(other.m_Block,new Block{})}
+    {
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr auto Storage<Tp,Nm,false>::operator=(Storage const& other) -> Storage&
+    {
+        if (this == &other) return *this;
+
+        *m_Block = *other.m_Block;
+        return *this;
+    }
+
+    template <typename Tp, size_t Nm>
+    constexpr auto Storage<Tp,Nm,false>::operator=(Storage&& other) noexcept -> Storage&
+    {
+        std::swap(m_Block,other.m_Block);
+        return *this;
+    }
+
+    template <typename Tp, size_t Al>
+    Tp* AlignedAllocator<Tp,Al>::allocate(size_t n)
+    {
+        if (n > max_size()) throw std::bad_array_new_length{};
+
+        auto const alignment = std::align_val_t{std::max(Al,alignof(Tp))};
+        return static_cast<Tp*>(::operator new(n * sizeof(Tp),alignment));
+    }
+
+    template <typename Tp, size_t Al>
+    void AlignedAllocator<Tp,Al>::deallocate(Tp* p, size_t) noexcept
+    {
+        auto const alignment = std::align_val_t{std::max(Al,alignof(Tp))};
+        ::operator delete(p,alignment);
+    }
+
+} // namespace mpp
+
+#endif /* __HH_MPP_STORAGE */
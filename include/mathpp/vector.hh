@@ -3,9 +3,12 @@
 #define __HH_MPP_VECTOR
 
 #include "mathpp/mathpp.hh"
+#include "mathpp/expr.hh"
+#include "mathpp/simd.hh"
 
-#include <vector>
+#include <array>
 #include <span>
+#include <algorithm>
 
 /* ************************************************************************** */
 // Definitions
@@ -14,64 +17,86 @@
 namespace mpp
 {
 
+    /*
+     * A fixed-length vector stored as a plain array, so that it is as large as
+     * its elements and no larger. Contiguous containers of vectors are then
+     * contiguous buffers of elements.
+     */
     template <typename Tp, size_t Nm, bool Vh>
     class VectorBase
     {
     public:
-        explicit VectorBase();
-        explicit VectorBase(Tp const&);
-        explicit VectorBase(std::span<Tp,Nm> const&);
-        virtual ~VectorBase() = default;
+        constexpr explicit VectorBase();
+        constexpr explicit VectorBase(Tp const&);
+        constexpr explicit VectorBase(std::span<Tp,Nm> const&);
 
         template <typename... Args>
             requires (std::conjunction<std::is_convertible<Args,Tp>...>::value)
                 && (sizeof...(Args) == Nm)
-        VectorBase(Args const&... args);
+        constexpr VectorBase(Args const&... args);
 
         template <typename... Args>
             requires (std::conjunction<std::is_same<Args,Tp>...>::value)
                 && (sizeof...(Args) == Nm)
-        VectorBase(Args&&... args);
+        constexpr VectorBase(Args&&... args);
 
         template <typename Tq>
             requires (std::is_convertible<Tq,Tp>::value)
-        VectorBase(VectorBase<Tq,Nm,Vh> const&);
+        constexpr VectorBase(VectorBase<Tq,Nm,Vh> const&);
+
+        template <typename E>
+            requires expression_proxy<E> && same_shape<E,VectorBase<Tp,Nm,Vh>>
+        constexpr VectorBase(E const&);
 
         template <typename Tq>
             requires (std::is_assignable<Tq,Tp>::value)
-        VectorBase<Tp,Nm,Vh>& operator=(VectorBase<Tq,Nm,Vh> const&);
+        constexpr VectorBase<Tp,Nm,Vh>& operator=(VectorBase<Tq,Nm,Vh> const&);
+
+        template <typename E>
+            requires expression_proxy<E> && same_shape<E,VectorBase<Tp,Nm,Vh>>
+        constexpr VectorBase<Tp,Nm,Vh>& operator=(E const&);
 
-        void swap(VectorBase<Tp,Nm,Vh>&);
+        constexpr void swap(VectorBase<Tp,Nm,Vh>&);
 
     public:
         constexpr static auto size() { return Nm; }
-        auto elements() const -> std::vector<Tp> const& { return m_Elements; }
+        constexpr auto elements() const -> std::array<Tp,Nm> const& { return m_Elements; }
+        constexpr auto data() const -> Tp const* { return m_Elements.data(); }
+        constexpr auto data() -> Tp* { return m_Elements.data(); }
 
-        void assign(Tp const&);
+        constexpr void assign(Tp const&);
 
         template <typename... Args>
             requires (std::conjunction<std::is_assignable<Args,Tp>...>::value)
                 && (sizeof...(Args) == Nm)
-        void assign(Args&&... args);
-
-        auto operator[](size_t i) const -> Tp const& { return m_Elements[i]; }
-        auto operator[](size_t i) -> Tp& { return m_Elements[i]; }
-        auto at(size_t i) const -> Tp const& { return m_Elements.at(i); }
-        auto at(size_t i) -> Tp& { return m_Elements.at(i); }
-
-        template <typename Tq>
-        VectorBase<Tp,Nm,Vh>& operator+=(VectorBase<Tq,Nm,Vh> const&);
-        template <typename Tq>
-        VectorBase<Tp,Nm,Vh>& operator-=(VectorBase<Tq,Nm,Vh> const&);
+        constexpr void assign(Args&&... args);
+
+        constexpr auto operator[](size_t i) const -> Tp const& { return m_Elements[i]; }
+        constexpr auto operator[](size_t i) -> Tp& { return m_Elements[i]; }
+        constexpr auto at(size_t i) const -> Tp const& { return m_Elements.at(i); }
+        constexpr auto at(size_t i) -> Tp& { return m_Elements.at(i); }
+
+        template <typename E>
+            requires same_shape<E,VectorBase<Tp,Nm,Vh>>
+        constexpr VectorBase<Tp,Nm,Vh>& operator+=(E const&);
+        template <typename E>
+            requires same_shape<E,VectorBase<Tp,Nm,Vh>>
+        constexpr VectorBase<Tp,Nm,Vh>& operator-=(E const&);
         template <typename Tq>
-        VectorBase<Tp,Nm,Vh>& operator*=(Tq const&);
+            requires (!expression<Tq>)
+        constexpr VectorBase<Tp,Nm,Vh>& operator*=(Tq const&);
         template <typename Tq>
-        VectorBase<Tp,Nm,Vh>& operator/=(Tq const&);
+            requires (!expression<Tq>)
+        constexpr VectorBase<Tp,Nm,Vh>& operator/=(Tq const&);
         template <typename Tq>
-        VectorBase<Tp,Nm,Vh>& operator%=(Tq const&);
+            requires (!expression<Tq>)
+        constexpr VectorBase<Tp,Nm,Vh>& operator%=(Tq const&);
 
     private:
-        std::vector<Tp> m_Elements{};
+        std::array<Tp,Nm> m_Elements{};
+
+        // the only member, so the vector is exactly as large as its elements
+        static_assert(sizeof(std::array<Tp,Nm>) == sizeof(Tp) * Nm);
     };
 
     template <typename Tp, size_t Nm>
@@ -82,6 +107,27 @@ namespace mpp
 
 } // namespace mpp
 
+/* ************************************************************************** */
+// Expression Specialisations
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, size_t Nm, bool Vh>
+    struct expression_traits<VectorBase<Tp,Nm,Vh>>
+    {
+        using value_type = Tp;
+        using result_type = VectorBase<Tp,Nm,Vh>;
+
+        template <typename Tr>
+        using rebind = VectorBase<Tr,Nm,Vh>;
+
+        constexpr static size_t size = Nm;
+    };
+
+} // namespace mpp
+
 /* ************************************************************************** */
 // MathPP Specialisations
 /* ************************************************************************** */
@@ -141,28 +187,31 @@ namespace mpp
 {
 
     template <typename Tp, size_t Nm, bool Vh>
-    VectorBase<Tp,Nm,Vh>::VectorBase()
-        : m_Elements(Nm,identity<Tp,op_add>::get())
+    constexpr VectorBase<Tp,Nm,Vh>::VectorBase()
+        : m_Elements{}
     {
+        m_Elements.fill(identity<Tp,op_add>::get());
     }
 
     template <typename Tp, size_t Nm, bool Vh>
-    VectorBase<Tp,Nm,Vh>::VectorBase(Tp const& value)
-        : m_Elements(Nm,value)
+    constexpr VectorBase<Tp,Nm,Vh>::VectorBase(Tp const& value)
+        : m_Elements{}
     {
+        m_Elements.fill(value);
     }
 
     template <typename Tp, size_t Nm, bool Vh>
-    VectorBase<Tp,Nm,Vh>::VectorBase(std::span<Tp,Nm> const& span)
-        : m_Elements(span.begin(),span.end())
+    constexpr VectorBase<Tp,Nm,Vh>::VectorBase(std::span<Tp,Nm> const& span)
+        : m_Elements{}
     {
+        std::copy(span.begin(),span.end(),m_Elements.begin());
     }
 
     template <typename Tp, size_t Nm, bool Vh>
     template <typename... Args>
         requires (std::conjunction<std::is_convertible<Args,Tp>...>::value)
             && (sizeof...(Args) == Nm)
-    VectorBase<Tp,Nm,Vh>::VectorBase(Args const&... args)
+    constexpr VectorBase<Tp,Nm,Vh>::VectorBase(Args const&... args)
         : m_Elements{static_cast<Tp>(args)...}
     {
     }
@@ -171,7 +220,7 @@ namespace mpp
     template <typename... Args>
         requires (std::conjunction<std::is_same<Args,Tp>...>::value)
             && (sizeof...(Args) == Nm)
-    VectorBase<Tp,Nm,Vh>::VectorBase(Args&&... args)
+    constexpr VectorBase<Tp,Nm,Vh>::VectorBase(Args&&... args)
         : m_Elements{std::forward<Args>(args)...}
     {
     }
@@ -179,20 +228,31 @@ namespace mpp
     template <typename Tp, size_t Nm, bool Vh>
     template <typename Tq>
         requires (std::is_convertible<Tq,Tp>::value)
-    VectorBase<Tp,Nm,Vh>::VectorBase(VectorBase<Tq,Nm,Vh> const& other)
+    constexpr VectorBase<Tp,Nm,Vh>::VectorBase(VectorBase<Tq,Nm,Vh> const& other)
+        : m_Elements{}
     {
-        m_Elements.reserve(Nm);
+        for (size_t i = 0; i < Nm; ++i)
+        {
+            m_Elements[i] = static_cast<Tp>(other[i]);
+        }
+    }
 
+    template <typename Tp, size_t Nm, bool Vh>
+    template <typename E>
+        requires expression_proxy<E> && same_shape<E,VectorBase<Tp,Nm,Vh>>
+    constexpr VectorBase<Tp,Nm,Vh>::VectorBase(E const& expr)
+        : m_Elements{}
+    {
         for (size_t i = 0; i < Nm; ++i)
         {
-            m_Elements.push_back(static_cast<Tp>(other[i]));
+            m_Elements[i] = static_cast<Tp>(expr[i]);
         }
     }
 
     template <typename Tp, size_t Nm, bool Vh>
     template <typename Tq>
         requires (std::is_assignable<Tq,Tp>::value)
-    VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator=(VectorBase<Tq,Nm,Vh> const& other)
+    constexpr VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator=(VectorBase<Tq,Nm,Vh> const& other)
     {
         for (size_t i = 0; i < Nm; ++i)
         {
@@ -202,33 +262,60 @@ namespace mpp
     }
 
     template <typename Tp, size_t Nm, bool Vh>
-    void VectorBase<Tp,Nm,Vh>::swap(VectorBase<Tp,Nm,Vh>& other)
+    template <typename E>
+        requires expression_proxy<E> && same_shape<E,VectorBase<Tp,Nm,Vh>>
+    constexpr VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator=(E const& expr)
+    {
+        if constexpr (holds_expression_view<E>::value)
+        {
+            return *this = expression_result_t<E>{expr};
+        }
+        // otherwise element-wise, so the expression may safely refer to this vector
+        for (size_t i = 0; i < Nm; ++i)
+        {
+            m_Elements[i] = static_cast<Tp>(expr[i]);
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    constexpr void VectorBase<Tp,Nm,Vh>::swap(VectorBase<Tp,Nm,Vh>& other)
     {
         std::swap(m_Elements,other.m_Elements);
     }
 
     template <typename Tp, size_t Nm, bool Vh>
-    void VectorBase<Tp,Nm,Vh>::assign(Tp const& value)
+    constexpr void VectorBase<Tp,Nm,Vh>::assign(Tp const& value)
     {
-        for (size_t i = 0; i < Nm; ++i)
-        {
-            m_Elements[i] = value;
-        }
+        m_Elements.fill(value);
     }
 
     template <typename Tp, size_t Nm, bool Vh>
     template <typename... Args>
         requires (std::conjunction<std::is_assignable<Args,Tp>...>::value)
             && (sizeof...(Args) == Nm)
-    void VectorBase<Tp,Nm,Vh>::assign(Args&&... args)
+    constexpr void VectorBase<Tp,Nm,Vh>::assign(Args&&... args)
     {
         m_Elements = {std::forward<Args>(args)...};
     }
 
     template <typename Tp, size_t Nm, bool Vh>
-    template <typename Tq>
-    VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator+=(VectorBase<Tq,Nm,Vh> const& other)
+    template <typename E>
+        requires same_shape<E,VectorBase<Tp,Nm,Vh>>
+    constexpr VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator+=(E const& other)
     {
+        if constexpr (holds_expression_view<E>::value)
+        {
+            return *this += expression_result_t<E>{other};
+        }
+        if constexpr (std::is_same<E,VectorBase<Tp,Nm,Vh>>::value && simd::supported<Tp> && Nm >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::add(data(),other.data(),Nm);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nm; ++i)
         {
             m_Elements[i] += other[i];
@@ -237,9 +324,22 @@ namespace mpp
     }
 
     template <typename Tp, size_t Nm, bool Vh>
-    template <typename Tq>
-    VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator-=(VectorBase<Tq,Nm,Vh> const& other)
+    template <typename E>
+        requires same_shape<E,VectorBase<Tp,Nm,Vh>>
+    constexpr VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator-=(E const& other)
     {
+        if constexpr (holds_expression_view<E>::value)
+        {
+            return *this -= expression_result_t<E>{other};
+        }
+        if constexpr (std::is_same<E,VectorBase<Tp,Nm,Vh>>::value && simd::supported<Tp> && Nm >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::sub(data(),other.data(),Nm);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nm; ++i)
         {
             m_Elements[i] -= other[i];
@@ -249,8 +349,17 @@ namespace mpp
 
     template <typename Tp, size_t Nm, bool Vh>
     template <typename Tq>
-    VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator*=(Tq const& scalar)
+        requires (!expression<Tq>)
+    constexpr VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator*=(Tq const& scalar)
     {
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp> && Nm >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::mul(data(),scalar,Nm);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nm; ++i)
         {
             m_Elements[i] *= scalar;
@@ -260,8 +369,17 @@ namespace mpp
 
     template <typename Tp, size_t Nm, bool Vh>
     template <typename Tq>
-    VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator/=(Tq const& scalar)
+        requires (!expression<Tq>)
+    constexpr VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator/=(Tq const& scalar)
     {
+        if constexpr (std::is_same<Tq,Tp>::value && simd::supported<Tp> && Nm >= simd::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                simd::div(data(),scalar,Nm);
+                return *this;
+            }
+        }
         for (size_t i = 0; i < Nm; ++i)
         {
             m_Elements[i] /= scalar;
@@ -271,7 +389,8 @@ namespace mpp
 
     template <typename Tp, size_t Nm, bool Vh>
     template <typename Tq>
-    VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator%=(Tq const& scalar)
+        requires (!expression<Tq>)
+    constexpr VectorBase<Tp,Nm,Vh>& VectorBase<Tp,Nm,Vh>::operator%=(Tq const& scalar)
     {
         for (size_t i = 0; i < Nm; ++i)
         {
@@ -291,7 +410,7 @@ namespace mpp
 
     template <typename Tp1, size_t Nm1, bool Vh1, typename Tp2, size_t Nm2, bool Vh2>
         requires requires (Tp1 a, Tp2 b) { a != b; }
-    bool operator==(VectorBase<Tp1,Nm1,Vh1> const& vector1, VectorBase<Tp2,Nm2,Vh2> const& vector2)
+    constexpr bool operator==(VectorBase<Tp1,Nm1,Vh1> const& vector1, VectorBase<Tp2,Nm2,Vh2> const& vector2)
     {
         if constexpr (Nm1 != Nm2) {
             return false;
@@ -303,108 +422,6 @@ namespace mpp
         return true;
     }
 
-    template <typename Tp, size_t Nm, bool Vh>
-        requires (identity<VectorBase<Tp,Nm,Vh>,op_add>::has() != logic::none)
-    auto operator+(VectorBase<Tp,Nm,Vh> const& vector)
-    {
-        VectorBase<Tp,Nm,Vh> result = identity<VectorBase<Tp,Nm,Vh>,op_add>::get();
-        return result + vector;
-    }
-
-    template <typename Tp, size_t Nm, bool Vh>
-        requires (identity<VectorBase<Tp,Nm,Vh>,op_add>::has() != logic::none)
-    auto operator-(VectorBase<Tp,Nm,Vh> const& vector)
-    {
-        VectorBase<Tp,Nm,Vh> result = identity<VectorBase<Tp,Nm,Vh>,op_add>::get();
-        return result - vector;
-    }
-
-    template <typename Tp, typename Tq, size_t Nm, bool Vh>
-        requires requires (Tp a, Tq b) { a + b; }
-    auto operator+(VectorBase<Tp,Nm,Vh> const& vector1, VectorBase<Tq,Nm,Vh> const& vector2)
-    {
-        using Tr = op_add::result<Tp,Tq>::type;
-        VectorBase<Tr,Nm,Vh> result = vector1;
-        return result += vector2;
-    }
-
-    template <typename Tp, typename Tq, size_t Nm, bool Vh>
-        requires requires (Tp a, Tq b) { a - b; }
-    auto operator-(VectorBase<Tp,Nm,Vh> const& vector1, VectorBase<Tq,Nm,Vh> const& vector2)
-    {
-        using Tr = op_add::result<Tp,Tq>::type;
-        VectorBase<Tr,Nm,Vh> result = vector1;
-        return result -= vector2;
-    }
-
-    template <typename Tp, typename Tq, size_t Nm, bool Vh>
-        requires requires (Tp a, Tq b) { a * b; }
-    auto operator*(VectorBase<Tp,Nm,Vh> const& vector, Tq const& scalar)
-    {
-        using Tr = op_mul::result<Tp,Tq>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nm);
-
-        for (size_t i = 0; i < Nm; ++i)
-        {
-            auto element = vector[i] * scalar;
-            elements.push_back(std::move(element));
-        }
-        std::span<Tr,Nm> span {elements.begin(),elements.end()};
-        return VectorBase<Tr,Nm,Vh>{span};
-    }
-
-    template <typename Tp, typename Tq, size_t Nm, bool Vh>
-        requires requires (Tp a, Tq b) { b * a; }
-    auto operator*(Tq const& scalar, VectorBase<Tp,Nm,Vh> const& vector)
-    {
-        using Tr = op_mul::result<Tp,Tq>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nm);
-
-        for (size_t i = 0; i < Nm; ++i)
-        {
-            auto element = scalar * vector[i];
-            elements.push_back(std::move(element));
-        }
-        std::span<Tr,Nm> span {elements.begin(),elements.end()};
-        return VectorBase<Tr,Nm,Vh>{span};
-    }
-
-    template <typename Tp, typename Tq, size_t Nm, bool Vh>
-        requires requires (Tp a, Tq b) { a / b; }
-    auto operator/(VectorBase<Tp,Nm,Vh> const& vector, Tq const& scalar)
-    {
-        using Tr = op_mul::result<Tp,Tq>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nm);
-
-        for (size_t i = 0; i < Nm; ++i)
-        {
-            auto element = vector[i] / scalar;
-            elements.push_back(std::move(element));
-        }
-        std::span<Tr,Nm> span {elements.begin(),elements.end()};
-        return VectorBase<Tr,Nm,Vh>{span};
-    }
-
-    template <typename Tp, typename Tq, size_t Nm, bool Vh>
-        requires (modulo<Tp,Tq>::has() != logic::none)
-    auto operator%(VectorBase<Tp,Nm,Vh> const& vector, Tq const& scalar)
-    {
-        using Tr = op_mul::result<Tp,Tq>::type;
-        std::vector<Tr> elements;
-        elements.reserve(Nm);
-
-        for (size_t i = 0; i < Nm; ++i)
-        {
-            auto element = modulo<Tp,Tq>::get(vector[i],scalar);
-            elements.push_back(std::move(element));
-        }
-        std::span<Tr,Nm> span {elements.begin(),elements.end()};
-        return VectorBase<Tr,Nm,Vh>{span};
-    }
-
 } // namespace mpp
 
 /* ************************************************************************** */
@@ -415,7 +432,7 @@ namespace std
 {
 
     template <typename Tp, size_t Nm, bool Vh>
-    void swap(mpp::VectorBase<Tp,Nm,Vh> const& vector1, mpp::VectorBase<Tp,Nm,Vh> const& vector2)
+    constexpr void swap(mpp::VectorBase<Tp,Nm,Vh>& vector1, mpp::VectorBase<Tp,Nm,Vh>& vector2)
     {
         vector1.swap(vector2);
     }
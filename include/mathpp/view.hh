@@ -0,0 +1,645 @@
+
+#ifndef __HH_MPP_VIEW
+#define __HH_MPP_VIEW
+
+#include "mathpp/mathpp.hh"
+#include "mathpp/expr.hh"
+#include "mathpp/gemm.hh"
+#include "mathpp/matrix.hh"
+#include "mathpp/vector.hh"
+
+#include <array>
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+
+/* ************************************************************************** */
+// Definitions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, size_t Nm, bool Vh = true>
+    class VectorView;
+
+    /*
+     * A non-owning view of `Nr` by `Nc` elements, addressed through a row and
+     * a column stride in the manner of `std::mdspan`. Views of `Tp const` are
+     * read-only. A view aliases the matrix it was taken from, so evaluate it
+     * before assigning it into overlapping elements.
+     */
+    template <typename Tp, size_t Nr, size_t Nc>
+    class MatrixView
+    {
+    public:
+        using value_type = std::remove_const_t<Tp>;
+
+        constexpr MatrixView(Tp*, size_t row_stride = Nc, size_t col_stride = 1);
+        constexpr MatrixView(Matrix<value_type,Nr,Nc>&);
+
+        constexpr MatrixView(Matrix<value_type,Nr,Nc> const&)
+            requires (std::is_const<Tp>::value);
+        constexpr MatrixView(MatrixView<value_type,Nr,Nc> const&)
+            requires (std::is_const<Tp>::value);
+
+        MatrixView(MatrixView const&) = default;
+        MatrixView& operator=(MatrixView const&) = default;
+
+    public:
+        constexpr static auto rows() { return Nr; }
+        constexpr static auto cols() { return Nc; }
+        constexpr static auto size() { return Nr*Nc; }
+        constexpr auto data() const -> Tp* { return m_Data; }
+        constexpr auto row_stride() const { return m_RowStride; }
+        constexpr auto col_stride() const { return m_ColStride; }
+        constexpr auto eval() const -> Matrix<value_type,Nr,Nc> { return Matrix<value_type,Nr,Nc>{*this}; }
+
+        constexpr auto operator[](size_t index) const -> Tp& { return (*this)[{index/Nc,index%Nc}]; }
+        constexpr auto operator[](std::array<size_t,2> const&) const -> Tp&;
+        constexpr auto at(std::array<size_t,2> const&) const -> Tp&;
+
+        constexpr auto transpose() const -> MatrixView<Tp,Nc,Nr>;
+        constexpr auto row(size_t) const -> VectorView<Tp,Nc,false>;
+        constexpr auto col(size_t) const -> VectorView<Tp,Nr,true>;
+        constexpr auto diagonal() const -> VectorView<Tp,std::min(Nr,Nc),true>;
+
+        template <size_t Mr, size_t Mc>
+            requires (Mr <= Nr && Mc <= Nc)
+        constexpr auto block(size_t, size_t) const -> MatrixView<Tp,Mr,Mc>;
+
+        template <typename E>
+            requires (!std::is_const<Tp>::value) && same_shape<E,MatrixView<Tp,Nr,Nc>>
+        constexpr MatrixView const& assign(E const&) const;
+
+        template <typename E>
+            requires (!std::is_const<Tp>::value) && same_shape<E,MatrixView<Tp,Nr,Nc>>
+        constexpr MatrixView const& operator+=(E const&) const;
+        template <typename E>
+            requires (!std::is_const<Tp>::value) && same_shape<E,MatrixView<Tp,Nr,Nc>>
+        constexpr MatrixView const& operator-=(E const&) const;
+        template <typename Tq>
+            requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+        constexpr MatrixView const& operator*=(Tq const&) const;
+        template <typename Tq>
+            requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+        constexpr MatrixView const& operator/=(Tq const&) const;
+
+    private:
+        Tp* m_Data;
+        size_t m_RowStride;
+        size_t m_ColStride;
+    };
+
+    /*
+     * A non-owning view of `Nm` elements a fixed stride apart, such as a row,
+     * a column or the diagonal of a matrix.
+     */
+    template <typename Tp, size_t Nm, bool Vh>
+    class VectorView
+    {
+    public:
+        using value_type = std::remove_const_t<Tp>;
+
+        constexpr VectorView(Tp*, size_t stride = 1);
+        constexpr VectorView(VectorBase<value_type,Nm,Vh>&);
+
+        constexpr VectorView(VectorBase<value_type,Nm,Vh> const&)
+            requires (std::is_const<Tp>::value);
+        constexpr VectorView(VectorView<value_type,Nm,Vh> const&)
+            requires (std::is_const<Tp>::value);
+
+        VectorView(VectorView const&) = default;
+        VectorView& operator=(VectorView const&) = default;
+
+    public:
+        constexpr static auto size() { return Nm; }
+        constexpr auto data() const -> Tp* { return m_Data; }
+        constexpr auto stride() const { return m_Stride; }
+        constexpr auto eval() const -> VectorBase<value_type,Nm,Vh> { return VectorBase<value_type,Nm,Vh>{*this}; }
+
+        constexpr auto operator[](size_t i) const -> Tp& { return m_Data[i*m_Stride]; }
+        constexpr auto at(size_t) const -> Tp&;
+
+        constexpr auto transpose() const -> VectorView<Tp,Nm,!Vh> { return {m_Data,m_Stride}; }
+
+        template <typename E>
+            requires (!std::is_const<Tp>::value) && same_shape<E,VectorView<Tp,Nm,Vh>>
+        constexpr VectorView const& assign(E const&) const;
+
+        template <typename E>
+            requires (!std::is_const<Tp>::value) && same_shape<E,VectorView<Tp,Nm,Vh>>
+        constexpr VectorView const& operator+=(E const&) const;
+        template <typename E>
+            requires (!std::is_const<Tp>::value) && same_shape<E,VectorView<Tp,Nm,Vh>>
+        constexpr VectorView const& operator-=(E const&) const;
+        template <typename Tq>
+            requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+        constexpr VectorView const& operator*=(Tq const&) const;
+        template <typename Tq>
+            requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+        constexpr VectorView const& operator/=(Tq const&) const;
+
+    private:
+        Tp* m_Data;
+        size_t m_Stride;
+    };
+
+    // matrices and vectors, whether owning or viewed
+
+    template <typename Tp>
+    struct is_matrix_operand : std::false_type
+    {};
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    struct is_matrix_operand<Matrix<Tp,Nr,Nc>> : std::true_type
+    {};
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    struct is_matrix_operand<MatrixView<Tp,Nr,Nc>> : std::true_type
+    {};
+
+    template <typename Tp>
+    concept matrix_operand = is_matrix_operand<std::remove_cvref_t<Tp>>::value;
+
+    template <typename Tp, bool Vh>
+    struct is_vector_operand : std::false_type
+    {};
+
+    template <typename Tp, size_t Nm, bool Vh>
+    struct is_vector_operand<VectorBase<Tp,Nm,Vh>,Vh> : std::true_type
+    {};
+
+    template <typename Tp, size_t Nm, bool Vh>
+    struct is_vector_operand<VectorView<Tp,Nm,Vh>,Vh> : std::true_type
+    {};
+
+    template <typename Tp, bool Vh>
+    concept vector_operand = is_vector_operand<std::remove_cvref_t<Tp>,Vh>::value;
+
+    // views may be taken of views, and of matrices that outlive them
+    template <typename Tp>
+    concept viewable = matrix_operand<Tp> && (expression_view<Tp> || std::is_lvalue_reference<Tp>::value);
+
+    namespace matrices
+    {
+
+        template <typename Tp, size_t Nr, size_t Nc>
+        constexpr auto view(Matrix<Tp,Nr,Nc>&) -> MatrixView<Tp,Nr,Nc>;
+        template <typename Tp, size_t Nr, size_t Nc>
+        constexpr auto view(Matrix<Tp,Nr,Nc> const&) -> MatrixView<Tp const,Nr,Nc>;
+
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto transpose(Mx&&);
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto row(Mx&&, size_t);
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto col(Mx&&, size_t);
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto diagonal(Mx&&);
+        template <size_t Mr, size_t Mc, typename Mx>
+            requires viewable<Mx>
+        constexpr auto block(Mx&&, size_t, size_t);
+
+        // the strided layout of a matrix operand, for the product kernels
+        template <typename Mx>
+            requires matrix_operand<Mx>
+        constexpr auto layout(Mx const&) -> gemm::layout<expression_value_t<Mx> const>;
+
+    } // namespace matrices
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Expression Specialisations
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    struct expression_traits<MatrixView<Tp,Nr,Nc>>
+    {
+        using value_type = std::remove_const_t<Tp>;
+        using result_type = Matrix<value_type,Nr,Nc>;
+        template <typename Tr>
+        using rebind = Matrix<Tr,Nr,Nc>;
+        constexpr static size_t size = Nr*Nc;
+    };
+
+    template <typename Tp, size_t Nm, bool Vh>
+    struct expression_traits<VectorView<Tp,Nm,Vh>>
+    {
+        using value_type = std::remove_const_t<Tp>;
+        using result_type = VectorBase<value_type,Nm,Vh>;
+        template <typename Tr>
+        using rebind = VectorBase<Tr,Nm,Vh>;
+        constexpr static size_t size = Nm;
+    };
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    struct is_expression_view<MatrixView<Tp,Nr,Nc>> : std::true_type
+    {};
+
+    template <typename Tp, size_t Nm, bool Vh>
+    struct is_expression_view<VectorView<Tp,Nm,Vh>> : std::true_type
+    {};
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Implementation
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr MatrixView<Tp,Nr,Nc>::MatrixView(Tp* data, size_t row_stride, size_t col_stride)
+        : m_Data{data}
+        , m_RowStride{row_stride}
+        , m_ColStride{col_stride}
+    {
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr MatrixView<Tp,Nr,Nc>::MatrixView(Matrix<value_type,Nr,Nc>& matrix)
+        : MatrixView{matrix.data()}
+    {
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr MatrixView<Tp,Nr,Nc>::MatrixView(Matrix<value_type,Nr,Nc> const& matrix)
+        requires (std::is_const<Tp>::value)
+        : MatrixView{matrix.data()}
+    {
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr MatrixView<Tp,Nr,Nc>::MatrixView(MatrixView<value_type,Nr,Nc> const& other)
+        requires (std::is_const<Tp>::value)
+        : MatrixView{other.data(),other.row_stride(),other.col_stride()}
+    {
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto MatrixView<Tp,Nr,Nc>::operator[](std::array<size_t,2> const& indices) const -> Tp&
+    {
+        return m_Data[indices[0]*m_RowStride + indices[1]*m_ColStride];
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto MatrixView<Tp,Nr,Nc>::at(std::array<size_t,2> const& indices) const -> Tp&
+    {
+        if (indices[0] >= Nr || indices[1] >= Nc) throw std::out_of_range("mpp::MatrixView::at");
+        return (*this)[indices];
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto MatrixView<Tp,Nr,Nc>::transpose() const -> MatrixView<Tp,Nc,Nr>
+    {
+        return {m_Data,m_ColStride,m_RowStride};
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto MatrixView<Tp,Nr,Nc>::row(size_t i) const -> VectorView<Tp,Nc,false>
+    {
+        if (i >= Nr) throw std::out_of_range("mpp::MatrixView::row");
+        return {m_Data + i*m_RowStride,m_ColStride};
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto MatrixView<Tp,Nr,Nc>::col(size_t j) const -> VectorView<Tp,Nr,true>
+    {
+        if (j >= Nc) throw std::out_of_range("mpp::MatrixView::col");
+        return {m_Data + j*m_ColStride,m_RowStride};
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    constexpr auto MatrixView<Tp,Nr,Nc>::diagonal() const -> VectorView<Tp,std::min(Nr,Nc),true>
+    {
+        return {m_Data,m_RowStride+m_ColStride};
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    template <size_t Mr, size_t Mc>
+        requires (Mr <= Nr && Mc <= Nc)
+    constexpr auto MatrixView<Tp,Nr,Nc>::block(size_t i, size_t j) const -> MatrixView<Tp,Mr,Mc>
+    {
+        if (i+Mr > Nr || j+Mc > Nc) throw std::out_of_range("mpp::MatrixView::block");
+        return {m_Data + i*m_RowStride + j*m_ColStride,m_RowStride,m_ColStride};
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    template <typename E>
+        requires (!std::is_const<Tp>::value) && same_shape<E,MatrixView<Tp,Nr,Nc>>
+    constexpr auto MatrixView<Tp,Nr,Nc>::assign(E const& other) const -> MatrixView const&
+    {
+        for (size_t i = 0; i < Nr; ++i)
+        {
+            for (size_t j = 0; j < Nc; ++j)
+            {
+                (*this)[{i,j}] = other[i*Nc+j];
+            }
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    template <typename E>
+        requires (!std::is_const<Tp>::value) && same_shape<E,MatrixView<Tp,Nr,Nc>>
+    constexpr auto MatrixView<Tp,Nr,Nc>::operator+=(E const& other) const -> MatrixView const&
+    {
+        for (size_t i = 0; i < Nr; ++i)
+        {
+            for (size_t j = 0; j < Nc; ++j)
+            {
+                (*this)[{i,j}] += other[i*Nc+j];
+            }
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    template <typename E>
+        requires (!std::is_const<Tp>::value) && same_shape<E,MatrixView<Tp,Nr,Nc>>
+    constexpr auto MatrixView<Tp,Nr,Nc>::operator-=(E const& other) const -> MatrixView const&
+    {
+        for (size_t i = 0; i < Nr; ++i)
+        {
+            for (size_t j = 0; j < Nc; ++j)
+            {
+                (*this)[{i,j}] -= other[i*Nc+j];
+            }
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    template <typename Tq>
+        requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+    constexpr auto MatrixView<Tp,Nr,Nc>::operator*=(Tq const& scalar) const -> MatrixView const&
+    {
+        for (size_t i = 0; i < Nr; ++i)
+        {
+            for (size_t j = 0; j < Nc; ++j)
+            {
+                (*this)[{i,j}] *= scalar;
+            }
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nr, size_t Nc>
+    template <typename Tq>
+        requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+    constexpr auto MatrixView<Tp,Nr,Nc>::operator/=(Tq const& scalar) const -> MatrixView const&
+    {
+        for (size_t i = 0; i < Nr; ++i)
+        {
+            for (size_t j = 0; j < Nc; ++j)
+            {
+                (*this)[{i,j}] /= scalar;
+            }
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    constexpr VectorView<Tp,Nm,Vh>::VectorView(Tp* data, size_t stride)
+        : m_Data{data}
+        , m_Stride{stride}
+    {
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    constexpr VectorView<Tp,Nm,Vh>::VectorView(VectorBase<value_type,Nm,Vh>& vector)
+        : VectorView{vector.data()}
+    {
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    constexpr VectorView<Tp,Nm,Vh>::VectorView(VectorBase<value_type,Nm,Vh> const& vector)
+        requires (std::is_const<Tp>::value)
+        : VectorView{vector.data()}
+    {
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    constexpr VectorView<Tp,Nm,Vh>::VectorView(VectorView<value_type,Nm,Vh> const& other)
+        requires (std::is_const<Tp>::value)
+        : VectorView{other.data(),other.stride()}
+    {
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    constexpr auto VectorView<Tp,Nm,Vh>::at(size_t i) const -> Tp&
+    {
+        if (i >= Nm) throw std::out_of_range("mpp::VectorView::at");
+        return (*this)[i];
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    template <typename E>
+        requires (!std::is_const<Tp>::value) && same_shape<E,VectorView<Tp,Nm,Vh>>
+    constexpr auto VectorView<Tp,Nm,Vh>::assign(E const& other) const -> VectorView const&
+    {
+        for (size_t i = 0; i < Nm; ++i)
+        {
+            (*this)[i] = other[i];
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    template <typename E>
+        requires (!std::is_const<Tp>::value) && same_shape<E,VectorView<Tp,Nm,Vh>>
+    constexpr auto VectorView<Tp,Nm,Vh>::operator+=(E const& other) const -> VectorView const&
+    {
+        for (size_t i = 0; i < Nm; ++i)
+        {
+            (*this)[i] += other[i];
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    template <typename E>
+        requires (!std::is_const<Tp>::value) && same_shape<E,VectorView<Tp,Nm,Vh>>
+    constexpr auto VectorView<Tp,Nm,Vh>::operator-=(E const& other) const -> VectorView const&
+    {
+        for (size_t i = 0; i < Nm; ++i)
+        {
+            (*this)[i] -= other[i];
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    template <typename Tq>
+        requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+    constexpr auto VectorView<Tp,Nm,Vh>::operator*=(Tq const& scalar) const -> VectorView const&
+    {
+        for (size_t i = 0; i < Nm; ++i)
+        {
+            (*this)[i] *= scalar;
+        }
+        return *this;
+    }
+
+    template <typename Tp, size_t Nm, bool Vh>
+    template <typename Tq>
+        requires (!std::is_const<Tp>::value) && (!expression<Tq>)
+    constexpr auto VectorView<Tp,Nm,Vh>::operator/=(Tq const& scalar) const -> VectorView const&
+    {
+        for (size_t i = 0; i < Nm; ++i)
+        {
+            (*this)[i] /= scalar;
+        }
+        return *this;
+    }
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Namespace Functions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    namespace matrices
+    {
+
+        template <typename Tp, size_t Nr, size_t Nc>
+        constexpr auto view(Matrix<Tp,Nr,Nc>& matrix) -> MatrixView<Tp,Nr,Nc>
+        {
+            return MatrixView<Tp,Nr,Nc>{matrix};
+        }
+
+        template <typename Tp, size_t Nr, size_t Nc>
+        constexpr auto view(Matrix<Tp,Nr,Nc> const& matrix) -> MatrixView<Tp const,Nr,Nc>
+        {
+            return MatrixView<Tp const,Nr,Nc>{matrix};
+        }
+
+        // matrices are viewed, and views are passed through
+
+        template <typename Mx>
+        constexpr auto as_view(Mx& operand)
+        {
+            if constexpr (expression_view<Mx>) {
+                return operand;
+            } else {
+                return view(operand);
+            }
+        }
+
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto transpose(Mx&& matrix)
+        {
+            return as_view(matrix).transpose();
+        }
+
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto row(Mx&& matrix, size_t i)
+        {
+            return as_view(matrix).row(i);
+        }
+
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto col(Mx&& matrix, size_t j)
+        {
+            return as_view(matrix).col(j);
+        }
+
+        template <typename Mx>
+            requires viewable<Mx>
+        constexpr auto diagonal(Mx&& matrix)
+        {
+            return as_view(matrix).diagonal();
+        }
+
+        template <size_t Mr, size_t Mc, typename Mx>
+            requires viewable<Mx>
+        constexpr auto block(Mx&& matrix, size_t i, size_t j)
+        {
+            return as_view(matrix).template block<Mr,Mc>(i,j);
+        }
+
+        template <typename Mx>
+            requires matrix_operand<Mx>
+        constexpr auto layout(Mx const& matrix) -> gemm::layout<expression_value_t<Mx> const>
+        {
+            if constexpr (expression_view<Mx>) {
+                return {matrix.data(),matrix.row_stride(),matrix.col_stride()};
+            } else {
+                return {matrix.data(),matrix.cols(),1};
+            }
+        }
+
+    } // namespace matrices
+
+} // namespace mpp
+
+/* ************************************************************************** */
+// Non-Member Extensions
+/* ************************************************************************** */
+
+namespace mpp
+{
+
+    /*
+     * Products of matrices where either operand is a view, read in place
+     * through the strides of the view.
+     */
+    template <typename E1, typename E2>
+        requires (expression_view<E1> || expression_view<E2>)
+            && matrix_operand<E1> && matrix_operand<E2>
+            && (std::remove_cvref_t<E1>::cols() == std::remove_cvref_t<E2>::rows())
+            && requires (expression_value_t<E1> a, expression_value_t<E2> b) { a * b; }
+    constexpr auto operator*(E1 const& matrix1, E2 const& matrix2)
+    {
+        using Tp = expression_value_t<E1>;
+        using Tq = expression_value_t<E2>;
+        using Tr = op_mul::result<Tp,Tq>::type;
+
+        constexpr size_t Nr = E1::rows(), Nc = E1::cols(), Nz = E2::cols();
+        Matrix<Tr,Nr,Nz> result {identity<Tr,op_add>::get()};
+
+        if constexpr (std::is_same<Tp,Tq>::value && std::is_same<Tr,Tp>::value
+            && std::is_arithmetic<Tp>::value && !std::is_same<Tp,bool>::value
+            && Nr*Nc*Nz >= gemm::threshold)
+        {
+            if (!std::is_constant_evaluated())
+            {
+                gemm::multiply<Tp>(Nr,Nz,Nc,
+                    matrices::layout(matrix1), matrices::layout(matrix2), {result.data(),Nz,1});
+                return result;
+            }
+        }
+
+        for (size_t i = 0; i < Nr; ++i)
+        {
+            for (size_t k = 0; k < Nc; ++k)
+            {
+                auto const& element = matrix1[{i,k}];
+                for (size_t j = 0; j < Nz; ++j)
+                {
+                    result[{i,j}] += element * matrix2[{k,j}];
+                }
+            }
+        }
+        return result;
+    }
+
+} // namespace mpp
+
+#endif /* __HH_MPP_VIEW */
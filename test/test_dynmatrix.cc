@@ -0,0 +1,138 @@
+
+#include "gtest/gtest.h"
+
+#include <mathpp/dynmatrix.hh>
+using namespace mpp;
+
+TEST(MPP_DYNMATRIX, LIFETIME)
+{
+    {
+        auto mat = DynMatrix<int>{2,3};                     // zero fill
+        EXPECT_EQ(mat.rows(),2u);
+        EXPECT_EQ(mat.cols(),3u);
+        EXPECT_TRUE(std::all_of(mat.elements().begin(),mat.elements().end(),[](int e){ return e == 0; }));
+    }
+    {
+        auto mat = DynMatrix<float>{64,64,1.0f};            // aligned storage
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mat.data()) % 64,0u);
+    }
+    {
+        auto alloc = AlignedAllocator<double>{};            // oversized request
+        EXPECT_THROW(alloc.allocate(alloc.max_size() + 1), std::bad_array_new_length);
+    }
+    {
+        EXPECT_THROW((DynMatrix<int>{2,2,{1,2,3}}), std::invalid_argument);
+    }
+    {
+        auto const fixed = Matrix<int,2,3>{1,2,3,4,5,6};
+        auto mat = DynMatrix<int>{fixed};                   // from fixed
+        EXPECT_TRUE(mat == (DynMatrix<int>{2,3,{1,2,3,4,5,6}}));
+
+        auto mat1 = static_cast<Matrix<int,2,3>>(mat);      // to fixed
+        EXPECT_TRUE(mat1 == fixed);
+        EXPECT_THROW((static_cast<Matrix<int,3,2>>(mat)), std::invalid_argument);
+    }
+    {
+        // Pooled storage through a memory resource
+        auto pool = std::pmr::unsynchronized_pool_resource{};
+        auto mat = pmr::DynMatrix<double>{3,3,2.0,&pool};
+        auto mat1 = mat * mat;
+        EXPECT_EQ(mat1.get_allocator().resource(),&pool);
+        EXPECT_EQ((mat1[{1,1}]),12.0);
+    }
+}
+
+TEST(MPP_DYNMATRIX, MATHPP)
+{
+    {
+        using identity = identity<DynMatrix<float>,op_mul>;
+        auto mat = identity::get(3);
+        EXPECT_TRUE((mat == DynMatrix<float>{Matrix<float,3,3>{1,0,0,0,1,0,0,0,1}}));
+    }
+    {
+        using inverse = inverse<DynMatrix<double>,op_mul>;
+        auto mat = DynMatrix<double>{2,2,{0,2,4,0}};
+        EXPECT_TRUE(inverse::can(mat));
+        EXPECT_TRUE(inverse::get(mat) == (DynMatrix<double>{2,2,{0,0.25,0.5,0}}));
+
+        EXPECT_FALSE(inverse::can(DynMatrix<double>{2,2,{1,2,2,4}}));
+        EXPECT_FALSE(inverse::can(DynMatrix<double>{2,3}));
+    }
+}
+
+TEST(MPP_DYNMATRIX, NAMESPACE)
+{
+    auto const mat = DynMatrix<int>{3,3,{2,0,1,1,3,2,1,1,2}};
+    {
+        EXPECT_EQ(matrices::determinant(mat),6);
+        EXPECT_EQ(matrices::trace(mat),7);
+        EXPECT_TRUE(matrices::submatrix(mat,0,0) == (DynMatrix<int>{2,2,{3,2,1,2}}));
+    }
+    {
+        auto const lu = matrices::LU<double>{DynMatrix<double>{mat}};
+        EXPECT_NEAR(lu.determinant(),6.0,1e-12);
+
+        auto b = std::vector<double>{3,6,4};
+        lu.solve(std::span{b});
+        EXPECT_NEAR(b[0],1,1e-12);
+        EXPECT_NEAR(b[1],1,1e-12);
+        EXPECT_NEAR(b[2],1,1e-12);
+    }
+    {
+        EXPECT_THROW(matrices::determinant(DynMatrix<int>{2,3}), std::invalid_argument);
+    }
+}
+
+TEST(MPP_DYNMATRIX, MATH)
+{
+    auto const mat1 = DynMatrix<double>{2,2,{1,2,3,4}};
+    auto const mat2 = DynMatrix<double>{2,2,{2,4,6,8}};
+    {
+        EXPECT_TRUE(mat1 + mat1 == mat2);
+        EXPECT_TRUE(mat2 - mat1 == mat1);
+        EXPECT_TRUE(mat1 * 2.0 == mat2);
+        EXPECT_TRUE(mat2 / 2.0 == mat1);
+        EXPECT_TRUE(-mat1 == mat1 - mat2);
+        EXPECT_THROW((mat1 + DynMatrix<double>{2,3}), std::invalid_argument);
+    }
+    {
+        auto const expected = DynMatrix<double>{2,2,{14,20,30,44}};
+        EXPECT_TRUE(mat1 * mat2 == expected);
+        EXPECT_THROW((mat1 * DynMatrix<double>{3,2}), std::invalid_argument);
+
+        auto result = expected / mat2;
+        for (size_t i = 0; i < 4; ++i) EXPECT_NEAR(result[i],mat1[i],1e-12);
+    }
+    {
+        // Large products agree with the fixed-size product
+        auto fixed1 = Matrix<double,40,30>{};
+        auto fixed2 = Matrix<double,30,50>{};
+        for (size_t i = 0; i < fixed1.size(); ++i) fixed1[i] = double(i % 7) - 3;
+        for (size_t i = 0; i < fixed2.size(); ++i) fixed2[i] = double(i % 5) - 2;
+
+        auto result = DynMatrix<double>{fixed1} * DynMatrix<double>{fixed2};
+        EXPECT_TRUE(result == DynMatrix<double>{fixed1 * fixed2});
+    }
+    {
+        // Promoted products, whose result type is not the element type
+        auto fixed1 = Matrix<short,16,16>{};
+        for (size_t i = 0; i < fixed1.size(); ++i) fixed1[i] = short(i % 9) - 4;
+
+        auto result = DynMatrix<short>{fixed1} * DynMatrix<short>{fixed1};
+        EXPECT_TRUE(result == DynMatrix<int>{fixed1 * fixed1});
+    }
+    {
+        // Promoted element-wise and scalar operations
+        auto const imat = DynMatrix<int>{2,2,{1,2,3,4}};
+        auto const dmat = DynMatrix<double>{2,2,{0.5,0.5,0.5,0.5}};
+
+        auto const scaled = imat * 2.5;
+        static_assert(std::is_same<decltype(scaled),DynMatrix<double> const>::value);
+        EXPECT_TRUE(scaled == (DynMatrix<double>{2,2,{2.5,5,7.5,10}}));
+        EXPECT_TRUE(2.5 * imat == scaled);
+        EXPECT_TRUE(imat / 2.0 == (DynMatrix<double>{2,2,{0.5,1,1.5,2}}));
+        EXPECT_TRUE(imat + dmat == (DynMatrix<double>{2,2,{1.5,2.5,3.5,4.5}}));
+        EXPECT_TRUE(imat - dmat == (DynMatrix<double>{2,2,{0.5,1.5,2.5,3.5}}));
+        EXPECT_TRUE(imat % 3 == (DynMatrix<int>{2,2,{1,2,0,1}}));
+    }
+}
@@ -0,0 +1,109 @@
+
+#include "gtest/gtest.h"
+
+#include <mathpp/poly.hh>
+using namespace mpp;
+
+#include <random>
+
+template <typename Tp>
+static auto schoolbook(std::vector<Tp> const& a, std::vector<Tp> const& b)
+{
+    std::vector<Tp> result(a.size()+b.size()-1);
+    polynomials::multiply_schoolbook(std::span<Tp>{result},std::span<Tp const>{a},std::span<Tp const>{b});
+    return result;
+}
+
+template <typename Tp>
+static auto random(size_t n, Tp magnitude, std::mt19937_64& engine)
+{
+    std::vector<Tp> result(n);
+    for (auto& value : result) value = Tp(engine() % uint64_t(2*magnitude+1)) - magnitude;
+    return result;
+}
+
+TEST(MPP_FFT, TRANSFORM)
+{
+    {
+        // the complex transform inverts
+        std::vector<std::complex<double>> data{1,2,3,4,5,6,7,8}, copy = data;
+        fft::transform(std::span<std::complex<double>>{data},false);
+        EXPECT_NEAR(data[0].real(),36,1e-12);
+        fft::transform(std::span<std::complex<double>>{data},true);
+        for (size_t i = 0; i < data.size(); ++i) EXPECT_NEAR(data[i].real(),copy[i].real(),1e-12);
+    }
+    {
+        // the number-theoretic transform inverts
+        std::vector<uint32_t> data{1,2,3,4,5,6,7,8}, copy = data;
+        fft::transform<fft::prime2>(data,false);
+        EXPECT_EQ(data[0],36);
+        fft::transform<fft::prime2>(data,true);
+        EXPECT_EQ(data,copy);
+    }
+    {
+        // products of residues modulo a transform prime
+        constexpr uint64_t P = fft::prime1::modulus;
+        std::vector<uint32_t> a(300), b(200);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = uint32_t((i * 2654435761u) % P);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = uint32_t((i * 40503u + 7) % P);
+
+        std::vector<uint32_t> result(a.size()+b.size()-1);
+        fft::multiply<fft::prime1>(result,a,b);
+
+        std::vector<uint64_t> expected(result.size());
+        for (size_t i = 0; i < a.size(); ++i)
+            for (size_t j = 0; j < b.size(); ++j)
+                expected[i+j] = (expected[i+j] + uint64_t(a[i]) * b[j]) % P;
+        EXPECT_TRUE(std::equal(result.begin(),result.end(),expected.begin()));
+    }
+}
+
+TEST(MPP_FFT, MULTIPLY)
+{
+    std::mt19937_64 engine{42};
+    {
+        // small integral operands round exactly from the complex transform
+        auto const a = random<long>(1500,1000,engine), b = random<long>(900,1000,engine);
+        std::vector<long> result(a.size()+b.size()-1);
+        EXPECT_TRUE(fft::multiply(std::span<long>{result},std::span<long const>{a},std::span<long const>{b}));
+        EXPECT_EQ(result,schoolbook(a,b));
+    }
+    {
+        // larger ones are recombined from three primes
+        auto const a = random<long>(9000,1L<<28,engine), b = random<long>(8500,1L<<28,engine);
+        std::vector<long> result(a.size()+b.size()-1);
+        EXPECT_TRUE(fft::multiply(std::span<long>{result},std::span<long const>{a},std::span<long const>{b}));
+        EXPECT_EQ(result,schoolbook(a,b));
+    }
+    {
+        // unless too short to pay for the modular transforms
+        auto const a = random<long>(600,1L<<28,engine), b = random<long>(600,1L<<28,engine);
+        std::vector<long> result(a.size()+b.size()-1);
+        EXPECT_FALSE(fft::multiply(std::span<long>{result},std::span<long const>{a},std::span<long const>{b}));
+    }
+    {
+        // integer-valued floating operands round exactly
+        auto const a = random<double>(2000,100,engine), b = random<double>(1000,100,engine);
+        std::vector<double> result(a.size()+b.size()-1);
+        EXPECT_TRUE(fft::multiply(std::span<double>{result},std::span<double const>{a},std::span<double const>{b}));
+        EXPECT_EQ(result,schoolbook(a,b));
+    }
+    {
+        // operators dispatch long products to the transforms
+        auto const a = random<int>(3000,100,engine), b = random<int>(2000,100,engine);
+        auto const product = Poly<int>{a} * Poly<int>{b};
+        EXPECT_EQ(product.coeffs(),schoolbook(a,b));
+
+        auto poly = Poly<int>{a};
+        poly *= Poly<int>{b};
+        EXPECT_EQ(poly.coeffs(),schoolbook(a,b));
+    }
+    {
+        std::vector<float> a(1000), b(1000);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = float(i % 7) * 0.25f;
+        for (size_t i = 0; i < b.size(); ++i) b[i] = float(i % 5) * 0.5f;
+        auto const product = Poly<float>{a} * Poly<float>{b};
+        auto const expected = schoolbook(a,b);
+        for (size_t i = 0; i < expected.size(); ++i) EXPECT_NEAR(product[i],expected[i],1e-2);
+    }
+}
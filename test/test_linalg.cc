@@ -36,3 +36,29 @@ TEST(MPP_LINEAR_ALGEBRA, VECTORS)
         EXPECT_TRUE(result == expected);
     }
 }
+
+TEST(MPP_LINEAR_ALGEBRA, LU_SOLVE)
+{
+    auto const matrix = Matrix<double,3,3>{2,1,1,4,-6,0,-2,7,2};
+    auto const lu = matrices::LU<double,3>{matrix};
+    {
+        auto const expected = Vector<double,3>{1,2,3};
+        auto result = lu.solve(Vector<double,3>{matrix * expected});
+        for (size_t i = 0; i < 3; ++i) EXPECT_NEAR(result[i],expected[i],1e-12);
+    }
+    {
+        // Batches of right-hand sides are solved in place
+        auto batch = std::vector<Vector<double,3>>{};
+        for (int k = 0; k < 8; ++k)
+        {
+            batch.push_back(matrix * Vector<double,3>{double(k),1.0,-double(k)});
+        }
+        lu.solve(std::span{batch});
+        for (int k = 0; k < 8; ++k)
+        {
+            EXPECT_NEAR(batch[k][0],k,1e-12);
+            EXPECT_NEAR(batch[k][1],1,1e-12);
+            EXPECT_NEAR(batch[k][2],-k,1e-12);
+        }
+    }
+}
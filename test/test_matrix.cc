@@ -7,22 +7,22 @@ using namespace mpp;
 TEST(MPP_MATRIX, LIFETIME)
 {
     {
-        auto elems = std::vector<int>{0,0,0,0};
+        auto elems = std::array<int,4>{0,0,0,0};
         auto mat = Matrix<int,2,2>{};                       // default
         EXPECT_EQ(mat.elements(),elems);
     }
     {
-        auto elems = std::vector<int>{1,1,1,1};
+        auto elems = std::array<int,4>{1,1,1,1};
         auto mat = Matrix<int,2,2>(1);                      // fill
         EXPECT_EQ(mat.elements(),elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3,4};
+        auto elems = std::array<int,4>{1,2,3,4};
         auto mat = Matrix<int,2,2>{1,2,3,4};                // forward elements
         EXPECT_EQ(mat.elements(),elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3,4};
+        auto elems = std::array<int,4>{1,2,3,4};
         auto mat = Matrix<int,2,2>{};
         mat = {1,2,3,4};                                    // assign initializer_list
         EXPECT_EQ(mat.elements(),elems);
@@ -71,6 +71,46 @@ TEST(MPP_MATRIX, LIFETIME)
     }
 }
 
+TEST(MPP_MATRIX, STORAGE)
+{
+    {
+        // small matrices are stored inline, and copy as plain bytes
+        static_assert(std::is_trivially_copyable<Matrix<float,3,3>>::value);
+        static_assert(sizeof(Matrix<float,4,4>) == 16*sizeof(float));
+        static_assert(alignof(Matrix<float,4,4>) == 64);
+    }
+    {
+        // small matrices are usable in constant expressions
+        constexpr auto mat1 = Matrix<int,2,2>{1,2,3,4};
+        constexpr Matrix<int,2,2> mat2 = mat1 * mat1 + mat1;
+        static_assert(mat2[{0,0}] == 8 && mat2[{1,1}] == 26);
+    }
+    {
+        // large matrices fall back to a single heap block
+        using Large = Matrix<double,64,64>;
+        static_assert(!std::is_trivially_copyable<Large>::value);
+
+        auto mat1 = Large{1.0};
+        auto mat2 = Large{mat1};
+        mat2[{63,63}] = 2.0;
+        EXPECT_EQ((mat1[{63,63}]), 1.0);
+        EXPECT_EQ((mat2[{63,63}]), 2.0);
+
+        auto mat3 = Large{std::move(mat2)};
+        EXPECT_EQ((mat2[{63,63}]), 0.0);                   // read moved-from
+        auto mat4 = Large{mat2};                            // copy moved-from
+        EXPECT_EQ((mat4[{0,0}]), 0.0);
+        mat2 = mat1;                                        // reassign moved-from
+        EXPECT_EQ((mat2[{63,63}]), 1.0);
+        EXPECT_EQ((mat3[{63,63}]), 2.0);
+    }
+    {
+        auto mat = Matrix<int,2,2>{1,2,3,4};
+        EXPECT_THROW(mat.at(4), std::out_of_range);
+        EXPECT_THROW((mat.at({0,2})), std::out_of_range);
+    }
+}
+
 TEST(MPP_MATRIX, MATHPP)
 {
     {
@@ -129,11 +169,12 @@ TEST(MPP_MATRIX, MATHPP)
         auto can = inverse::can(mat1);
         EXPECT_TRUE(can);
 
+        // Pivoted elimination rounds to within a few ulps
         auto mat2 = inverse::get(mat1);
-        EXPECT_TRUE(mat2 == mat);
+        for (size_t i = 0; i < 4; ++i) EXPECT_FLOAT_EQ(mat2[i],mat[i]);
 
         inverse::make(mat1);
-        EXPECT_TRUE(mat2 == mat);
+        for (size_t i = 0; i < 4; ++i) EXPECT_FLOAT_EQ(mat1[i],mat[i]);
     }
     {
         // Matrices with zero determinant are not invertible
@@ -167,7 +208,7 @@ TEST(MPP_MATRIX, NAMESPACE)
     {
         auto mat = Matrix<float,2,2>{1,2,3,4};
         auto det = matrices::determinant(mat);
-        EXPECT_EQ(det,-2.0f);
+        EXPECT_FLOAT_EQ(det,-2.0f);
     }
     {
         auto mat = Matrix<float,3,3>{1,2,3,4,5,6,7,8,9};
@@ -176,37 +217,120 @@ TEST(MPP_MATRIX, NAMESPACE)
     }
 }
 
+TEST(MPP_MATRIX, DETERMINANT)
+{
+    auto const mat = Matrix<int,6,6>{
+        0, 2,-1, 3, 1, 4,
+        5, 0, 2,-2, 1, 0,
+        1, 3, 0, 4,-1, 2,
+        2,-1, 3, 0, 2, 1,
+        0, 1, 1,-3, 0, 5,
+        4, 2, 0, 1,-2, 0,
+    };
+    {
+        // Integral matrices are fraction-free, and exact
+        auto det = matrices::determinant(mat);
+        EXPECT_EQ(det,-1016);
+        EXPECT_EQ(matrices::determinant_cofactor(mat),-1016);
+    }
+    {
+        auto det = matrices::determinant(Matrix<double,6,6>{mat});
+        EXPECT_NEAR(det,-1016.0,1e-9);
+    }
+    {
+        // Permuted triangular matrices need pivoting
+        auto mat1 = Matrix<double,12,12>{};
+        auto mat2 = Matrix<long,12,12>{};
+        for (size_t i = 0; i < 12; ++i)
+        {
+            for (size_t j = i; j < 12; ++j)
+            {
+                mat1[{(i+1)%12,j}] = (i == j) ? 2 : 1;
+                mat2[{(i+1)%12,j}] = (i == j) ? 2 : 1;
+            }
+        }
+        EXPECT_EQ(matrices::determinant(mat1),-4096.0);
+        EXPECT_EQ(matrices::determinant(mat2),-4096L);
+    }
+    {
+        auto mat1 = Matrix<int,3,3>{1,2,3,2,4,6,7,8,9};
+        EXPECT_EQ(matrices::determinant(mat1),0);
+    }
+    {
+        // Unsigned integers wrap, so their minors are not exact multiples
+        static_assert(matrices::exact_division<long>::value);
+        static_assert(!matrices::exact_division<unsigned>::value);
+    }
+}
+
+TEST(MPP_MATRIX, LU)
+{
+    auto const mat = Matrix<double,4,4>{
+        0, 2, 1, 3,
+        1, 1, 0, 2,
+        4,-1, 2, 0,
+        2, 0, 3, 1,
+    };
+    auto const lu = matrices::LU<double,4>{mat};
+    {
+        EXPECT_FALSE(lu.singular());
+        EXPECT_NEAR(lu.determinant(),matrices::determinant_cofactor(mat),1e-12);
+    }
+    {
+        auto const x = Matrix<double,4,2>{1,-1, 2,0, 3,1, 4,2};
+        auto result = lu.solve(mat * x);
+        for (size_t i = 0; i < 8; ++i) EXPECT_NEAR(result[i],x[i],1e-12);
+    }
+    {
+        // Right division solves against the factors
+        auto const x = Matrix<double,2,4>{1,2,3,4, -1,0,1,2};
+        auto result = (x * mat) / mat;
+        for (size_t i = 0; i < 8; ++i) EXPECT_NEAR(result[i],x[i],1e-12);
+    }
+    {
+        auto const ident = identity<Matrix<double,4,4>,op_mul>::get();
+        auto result = mat * lu.inverse();
+        for (size_t i = 0; i < 16; ++i) EXPECT_NEAR(result[i],ident[i],1e-12);
+    }
+    {
+        auto const singular = matrices::LU<float,3>{Matrix<float,3,3>{1,2,3,2,4,6,7,8,9}};
+        EXPECT_TRUE(singular.singular());
+        EXPECT_EQ(singular.determinant(),0.0f);
+        EXPECT_THROW(singular.solve(Matrix<float,3,1>{}), std::domain_error);
+    }
+}
+
 TEST(MPP_MATRIX, MATH_SELF)
 {
     auto const mat1 = Matrix<float,2,2>{1,2,3,4};
     auto const mat2 = Matrix<float,2,2>{2,4,6,8};
     auto const scalar = 2.0f;
     {
-        auto elems = std::vector<float>{3,6,9,12};
+        auto elems = std::array<float,4>{3,6,9,12};
         auto mat = mat2;
         mat += mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{1,2,3,4};
+        auto elems = std::array<float,4>{1,2,3,4};
         auto mat = mat2;
         mat -= mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{2,4,6,8};
+        auto elems = std::array<float,4>{2,4,6,8};
         auto mat = mat1;
         mat *= scalar;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{1,2,3,4};
+        auto elems = std::array<float,4>{1,2,3,4};
         auto mat = mat2;
         mat /= scalar;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{1,0,1,0};
+        auto elems = std::array<float,4>{1,0,1,0};
         auto mat = mat1;
         mat %= scalar;
         EXPECT_EQ(mat.elements(), elems);
@@ -219,48 +343,158 @@ TEST(MPP_MATRIX, MATH_OTHER)
     auto const mat2 = Matrix<float,2,2>{2,4,6,8};
     auto const scalar = 2.0f;
     {
-        auto elems = std::vector<float>{1,2,3,4};
+        auto elems = std::array<float,4>{1,2,3,4};
         auto mat = +mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{-1,-2,-3,-4};
+        auto elems = std::array<float,4>{-1,-2,-3,-4};
         auto mat = -mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{3,6,9,12};
+        auto elems = std::array<float,4>{3,6,9,12};
         auto mat = mat2 + mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{1,2,3,4};
+        auto elems = std::array<float,4>{1,2,3,4};
         auto mat = mat2 - mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{14,20,30,44};
+        auto elems = std::array<float,4>{14,20,30,44};
         auto mat = mat2 * mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{2,0,0,2};
+        auto elems = std::array<float,4>{2,0,0,2};
         auto mat = mat2 / mat1;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{2,4,6,8};
+        auto elems = std::array<float,4>{2,4,6,8};
         auto mat = mat1 * scalar;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{1,2,3,4};
+        auto elems = std::array<float,4>{1,2,3,4};
         auto mat = mat2 / scalar;
         EXPECT_EQ(mat.elements(), elems);
     }
     {
-        auto elems = std::vector<float>{1,0,1,0};
+        auto elems = std::array<float,4>{1,0,1,0};
         auto mat = mat1 % scalar;
         EXPECT_EQ(mat.elements(), elems);
     }
 }
+
+TEST(MPP_MATRIX, EXPRESSION)
+{
+    auto const mat1 = Matrix<float,2,2>{3,6,9,12};
+    auto const mat2 = Matrix<float,2,2>{1,2,3,4};
+    {
+        // element-wise expressions are evaluated once, on assignment
+        auto expr = mat1*2 + mat2 - mat1/3;
+        static_assert(!std::is_same<decltype(expr),Matrix<float,2,2>>::value);
+
+        Matrix<float,2,2> mat = expr;
+        EXPECT_TRUE(mat == (Matrix<float,2,2>{6,12,18,24}));
+        EXPECT_TRUE(expr == mat);
+    }
+    {
+        // expressions promote their element types like their operands
+        auto const mat3 = Matrix<int,2,2>{1,2,3,4};
+        Matrix<int,2,2> mat = mat3 + mat2;
+        EXPECT_TRUE(mat == (Matrix<int,2,2>{2,4,6,8}));
+    }
+    {
+        // temporaries are held by value, so expressions never dangle
+        auto expr = (mat1 * mat2) + Matrix<float,2,2>{1.0f};
+        auto elems = std::array<float,4>{22,31,46,67};
+        EXPECT_EQ(expr.elements(), elems);
+    }
+    {
+        // non element-wise products evaluate their expression operands
+        auto mat = (mat1 - mat2) * (mat2 + mat2);
+        auto elems = std::array<float,4>{28,40,60,88};
+        EXPECT_EQ(mat.elements(), elems);
+    }
+    {
+        // assigning an expression that refers to its target is safe
+        auto mat = mat2;
+        mat = mat * 2 + mat;
+        auto elems = std::array<float,4>{3,6,9,12};
+        EXPECT_EQ(mat.elements(), elems);
+    }
+}
+
+TEST(MPP_MATRIX, PRODUCT)
+{
+    // large products run through the blocked kernel, and must agree with
+    // the plain triple loop, including on ragged edges of the blocking
+    auto const reference = [](auto const& mat1, auto const& mat2, auto& result)
+    {
+        for (size_t i = 0; i < mat1.rows(); ++i)
+            for (size_t j = 0; j < mat2.cols(); ++j)
+                for (size_t k = 0; k < mat1.cols(); ++k)
+                    result[{i,j}] += mat1[{i,k}] * mat2[{k,j}];
+    };
+    {
+        auto mat1 = Matrix<long,67,45>{};
+        auto mat2 = Matrix<long,45,83>{};
+        for (size_t i = 0; i < mat1.size(); ++i) mat1[i] = static_cast<long>(i % 17) - 8;
+        for (size_t i = 0; i < mat2.size(); ++i) mat2[i] = static_cast<long>(i % 13) - 6;
+
+        auto expected = Matrix<long,67,83>{0};
+        reference(mat1,mat2,expected);
+        auto result = mat1 * mat2;
+        EXPECT_TRUE(result == expected);
+    }
+    {
+        auto mat1 = Matrix<double,130,300>{};
+        auto mat2 = Matrix<double,300,70>{};
+        for (size_t i = 0; i < mat1.size(); ++i) mat1[i] = 1.0 / static_cast<double>(i % 31 + 1);
+        for (size_t i = 0; i < mat2.size(); ++i) mat2[i] = static_cast<double>(i % 7) - 3.0;
+
+        auto expected = Matrix<double,130,70>{0.0};
+        reference(mat1,mat2,expected);
+        auto result = mat1 * mat2;
+        for (size_t i = 0; i < result.size(); ++i)
+        {
+            EXPECT_NEAR(result[i], expected[i], 1e-9);
+        }
+    }
+    {
+        // promoted products, whose result type is not the element type
+        auto mat1 = Matrix<short,16,16>{};
+        auto mat2 = Matrix<short,16,16>{};
+        for (size_t i = 0; i < mat1.size(); ++i) mat1[i] = static_cast<short>(i % 11) - 5;
+        for (size_t i = 0; i < mat2.size(); ++i) mat2[i] = static_cast<short>(i % 9) - 4;
+
+        auto expected = Matrix<int,16,16>{0};
+        reference(mat1,mat2,expected);
+        auto result = mat1 * mat2;
+        EXPECT_TRUE(result == expected);
+    }
+}
+
+TEST(MPP_MATRIX, MATH_SIMD)
+{
+    // large matrices run through the vectorised kernels, including the tail
+    auto mat1 = Matrix<float,7,9>{};
+    auto mat2 = Matrix<float,7,9>{};
+    for (size_t i = 0; i < mat1.size(); ++i)
+    {
+        mat1[i] = static_cast<float>(i);
+        mat2[i] = static_cast<float>(3*i);
+    }
+    mat1 += mat2;
+    mat1 *= 2.0f;
+    mat1 -= mat2;
+    mat1 /= 5.0f;
+    for (size_t i = 0; i < mat1.size(); ++i)
+    {
+        EXPECT_EQ(mat1[i], static_cast<float>(i));
+    }
+}
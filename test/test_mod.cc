@@ -1,9 +1,19 @@
 
 #include "gtest/gtest.h"
 #include <mathpp/mod.hh>
+#include <mathpp/poly.hh>
+
+#include <array>
 
 TEST(MPP_MOD, LIFETIME)
 {
+    {
+        // a plain value type, packed densely in arrays
+        static_assert(std::is_final<mpp::Mod<int>>::value);
+        static_assert(!std::is_polymorphic<mpp::Mod<int>>::value);
+        static_assert(sizeof(mpp::Mod<int>) == 2*sizeof(int));
+        static_assert(sizeof(mpp::Mod<uint32_t>) == 2*sizeof(uint32_t));
+    }
     {
         auto mod = mpp::Mod<int>{7};                        // default
         EXPECT_EQ(mod.value(), 0);
@@ -344,3 +354,387 @@ TEST(MPP_MOD, MATH_EXTRA)
         EXPECT_TRUE(-mod1 == mod2);
     }
 }
+
+TEST(MPP_MOD, MONTGOMERY)
+{
+    using mpp::op_add;  using mpp::op_mul;
+    {
+        // values round trip through the form, and even moduli are refused
+        auto const mont = mpp::Montgomery<uint32_t>{mpp::Mod<uint32_t>{1000003,12345678}};
+        EXPECT_EQ(mont.value(), 12345678u % 1000003u);
+        EXPECT_TRUE(static_cast<mpp::Mod<uint32_t>>(mont) == (mpp::Mod<uint32_t>{1000003,12345678}));
+        EXPECT_THROW(mpp::Montgomery<uint32_t>{1000}, std::invalid_argument);
+    }
+    {
+        // chains of products agree with double-width remainders
+        constexpr uint64_t m = 0xffffffffffffffc5; // the largest 64-bit prime
+        auto acc = mpp::Montgomery<uint64_t>{m,1};
+        auto const base = mpp::Montgomery<uint64_t>{m,0x123456789abcdef};
+        unsigned __int128 expected = 1;
+        for (int i = 0; i < 1000; ++i)
+        {
+            acc *= base;
+            expected = expected * 0x123456789abcdef % m;
+        }
+        EXPECT_EQ(acc.value(), uint64_t(expected));
+    }
+    {
+        // sums and differences wrap at the modulus
+        auto const a = mpp::Montgomery<uint16_t>{65521,65000}, b = mpp::Montgomery<uint16_t>{65521,1000};
+        EXPECT_EQ((a + b).value(), 479);
+        EXPECT_EQ((b - a).value(), 1521);
+        EXPECT_EQ((a * b).value(), uint16_t(65000u * 1000u % 65521u));
+        EXPECT_TRUE(-a + a == (mpp::Montgomery<uint16_t>{65521}));
+    }
+    {
+        // the identity and inverse traits
+        using one = mpp::identity<mpp::Montgomery<uint32_t>,op_mul>;
+        using zero = mpp::identity<mpp::Montgomery<uint32_t>,op_add>;
+        using inverse = mpp::inverse<mpp::Montgomery<uint32_t>,op_mul>;
+        EXPECT_EQ(one::get(97).value(), 1);
+        EXPECT_EQ(zero::get(97).value(), 0);
+
+        auto const a = mpp::Montgomery<uint32_t>{97,35};
+        EXPECT_TRUE(inverse::can(a));
+        EXPECT_TRUE(a * inverse::get(a) == one::get(97));
+        EXPECT_FALSE(inverse::can(mpp::Montgomery<uint32_t>{99,33}));
+        EXPECT_THROW(inverse::get(mpp::Montgomery<uint32_t>{99,33}), std::domain_error);
+        EXPECT_EQ(mpp::modular::invert<uint64_t>(3,0xffffffffffffffc5), 0x5555555555555542);
+    }
+}
+
+TEST(MPP_MOD, BARRETT)
+{
+    using mpp::op_add;  using mpp::op_mul;
+    {
+        // products of residues no longer overflow before they are reduced
+        auto mod = mpp::Mod<int>{2147483629,2147483000};
+        mod *= 2147483001;
+        EXPECT_EQ(mod.value(), int(2147483000LL * 2147483001LL % 2147483629LL));
+        auto const neg = mpp::Mod<int>{1000003,5} * -7;
+        EXPECT_EQ(neg.value(), 1000003 - 35);
+        auto const product = mpp::Mod<long>{(1L<<62)+1,1L<<40} * mpp::Mod<long>{(1L<<62)+1,1L<<40};
+        EXPECT_EQ(product.value(), (1L<<62)+1 - (1L<<18));
+    }
+    {
+        // even moduli, and chains of products agree with double-width remainders
+        constexpr uint64_t m = (1ULL<<62) + 12345678;
+        auto acc = mpp::Barrett<uint64_t>{m,1};
+        auto const base = mpp::Barrett<uint64_t>{m,0x3456789abcdef01};
+        unsigned __int128 expected = 1;
+        for (int i = 0; i < 1000; ++i)
+        {
+            acc *= base;
+            expected = expected * 0x3456789abcdef01 % m;
+        }
+        EXPECT_EQ(acc.value(), uint64_t(expected));
+        EXPECT_THROW(mpp::Barrett<uint64_t>{(1ULL<<63)+1}, std::invalid_argument);
+        EXPECT_THROW(mpp::Barrett<uint64_t>{0}, std::invalid_argument);
+    }
+    {
+        // every product of small residues reduces exactly
+        for (uint16_t m : {1, 2, 3, 1000, 16384, 32767, 32768})
+        {
+            for (uint32_t a = 0; a < m; a += 1 + m/97)
+                for (uint32_t b = 0; b < m; b += 1 + m/89)
+                    EXPECT_EQ((mpp::Barrett<uint16_t>{m,uint16_t(a)} * mpp::Barrett<uint16_t>{m,uint16_t(b)}).value(), a * b % m);
+        }
+    }
+    {
+        // above a third of the range the uncorrected remainder overflows Tp,
+        // so many products of moduli up to the bound are checked
+        size_t wrong = 0;
+        uint64_t state = 0x9e3779b97f4a7c15ULL;
+        for (uint32_t m : {1431655766u, 2110021660u, 2147483647u, 2147483648u})
+        {
+            for (int i = 0; i < 100000; ++i)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                uint32_t const x = uint32_t(state >> 32) % m, y = uint32_t(state) % m;
+                auto const product = mpp::Barrett<uint32_t>{m,x} * mpp::Barrett<uint32_t>{m,y};
+                wrong += product.value() != uint64_t(x) * y % m;
+            }
+        }
+        EXPECT_EQ(wrong, 0u);
+
+        auto const a = mpp::Barrett<uint32_t>{2110021660u,2040832682u};
+        auto const b = mpp::Barrett<uint32_t>{2110021660u,1873948619u};
+        EXPECT_EQ((a * b).value(), 90342018u);
+    }
+    {
+        // sums, differences, and the traits
+        auto const a = mpp::Barrett<uint32_t>{1000,999}, b = mpp::Barrett<uint32_t>{1000,3};
+        EXPECT_EQ((a + b).value(), 2);
+        EXPECT_EQ((b - a).value(), 4);
+        EXPECT_TRUE((-a + a == mpp::identity<mpp::Barrett<uint32_t>,op_add>::get(1000)));
+        EXPECT_TRUE(static_cast<mpp::Mod<uint32_t>>(a) == (mpp::Mod<uint32_t>{1000,999}));
+
+        using inverse = mpp::inverse<mpp::Barrett<uint32_t>,op_mul>;
+        EXPECT_TRUE((a * inverse::get(a) == mpp::identity<mpp::Barrett<uint32_t>,op_mul>::get(1000)));
+        EXPECT_FALSE(inverse::can(b + b));
+    }
+}
+
+TEST(MPP_MOD, STATIC)
+{
+    using mpp::op_add;  using mpp::op_mul;
+    using Residue = mpp::StaticMod<uint32_t,998244353>;
+    {
+        // one word per residue, with arithmetic available at compile time
+        static_assert(sizeof(Residue) == sizeof(uint32_t));
+        static_assert(sizeof(std::array<Residue,8>) == 8*sizeof(uint32_t));
+        static_assert((mpp::StaticMod<uint8_t,7>{5} * mpp::StaticMod<uint8_t,7>{4}).value() == 6);
+        static_assert(Residue::modulus() == 998244353);
+        static_assert(mpp::identity<Residue,op_mul>::get().value() == 1);
+    }
+    {
+        // chains of products agree with double-width remainders
+        constexpr uint64_t m = (1ULL<<62) + 135;
+        auto acc = mpp::StaticMod<uint64_t,m>{1};
+        auto const base = mpp::StaticMod<uint64_t,m>{0x3456789abcdef01};
+        unsigned __int128 expected = 1;
+        for (int i = 0; i < 1000; ++i)
+        {
+            acc *= base;
+            expected = expected * 0x3456789abcdef01 % m;
+        }
+        EXPECT_EQ(acc.value(), uint64_t(expected));
+    }
+    {
+        // moduli above a third of the range, where remainders pass 2^bits
+        using Wide = mpp::StaticMod<uint32_t,2110021660u>;
+        EXPECT_EQ((Wide{2040832682u} * Wide{1873948619u}).value(), 90342018u);
+        static_assert((Wide{2040832682u} * Wide{1873948619u}).value() == 90342018u);
+
+        auto acc = Wide{1};
+        uint64_t expected = 1;
+        for (uint32_t i = 1; i <= 10000; ++i)
+        {
+            acc *= Wide{i * 2654435761u};
+            expected = expected * ((i * 2654435761u) % 2110021660u) % 2110021660u;
+        }
+        EXPECT_EQ(acc.value(), expected);
+    }
+    {
+        // sums, differences, steps, and conversions
+        auto a = Residue{998244350}, b = Residue{5};
+        EXPECT_EQ((a + b).value(), 2);
+        EXPECT_EQ((b - a).value(), 8);
+        EXPECT_TRUE(-a + a == Residue{});
+        EXPECT_EQ((++a).value(), 998244351);
+        EXPECT_EQ((--Residue{}).value(), 998244352);
+        EXPECT_TRUE((Residue{mpp::Mod<uint32_t>{998244353,3}} == Residue{3}));
+        EXPECT_THROW((Residue{mpp::Mod<uint32_t>{7,3}}), std::invalid_argument);
+        EXPECT_TRUE(static_cast<mpp::Mod<uint32_t>>(b) == (mpp::Mod<uint32_t>{998244353,5}));
+    }
+    {
+        // inverses, and residues as polynomial coefficients
+        using inverse = mpp::inverse<Residue,op_mul>;
+        auto const a = Residue{123456789};
+        EXPECT_TRUE((a * inverse::get(a) == mpp::identity<Residue,op_mul>::get()));
+        EXPECT_FALSE(inverse::can(Residue{}));
+        EXPECT_THROW(inverse::get(Residue{}), std::domain_error);
+
+        auto const poly = mpp::Poly<Residue>{Residue{1},Residue{998244352}} * mpp::Poly<Residue>{Residue{1},Residue{1}};
+        EXPECT_TRUE(poly[0] == Residue{1});
+        EXPECT_TRUE(poly[1] == Residue{0});
+        EXPECT_TRUE(poly[2] == Residue{998244352});
+    }
+    {
+        // quotients by the inverse, and polynomial division and interpolation
+        EXPECT_TRUE(Residue{6} / Residue{3} == Residue{2});
+        EXPECT_TRUE(Residue{1} / Residue{2} * Residue{2} == Residue{1});
+        EXPECT_THROW(Residue{1} / Residue{}, std::domain_error);
+
+        auto const divisor = mpp::Poly<Residue>{Residue{1},Residue{0},Residue{3}};
+        auto const quotient = mpp::Poly<Residue>{Residue{2},Residue{5}};
+        auto const remainder = mpp::Poly<Residue>{Residue{7},Residue{4}};
+        auto const dividend = divisor * quotient + remainder;
+        EXPECT_TRUE((dividend % divisor).coeffs() == remainder.coeffs());
+        auto const [r,q] = mpp::division<mpp::Poly<Residue>,mpp::Poly<Residue>>::get(dividend,divisor);
+        EXPECT_TRUE(r.coeffs() == remainder.coeffs());
+        EXPECT_TRUE(q.coeffs() == quotient.coeffs());
+
+        // long divisors divide by Newton iteration on the reciprocal
+        std::vector<Residue> long_divisor(1100), long_quotient(1030);
+        for (uint32_t i = 0; i < long_divisor.size(); ++i) long_divisor[i] = Residue{i*i + 7};
+        for (uint32_t i = 0; i < long_quotient.size(); ++i) long_quotient[i] = Residue{3*i + 1};
+        long_divisor.back() = Residue{1};
+        auto const long_dividend = mpp::Poly<Residue>{long_divisor} * mpp::Poly<Residue>{long_quotient} + remainder;
+        EXPECT_TRUE((long_dividend % mpp::Poly<Residue>{long_divisor}).coeffs() == remainder.coeffs());
+
+        // past the threshold for interpolation by subproduct tree
+        std::vector<Residue> points, coeffs;
+        for (uint32_t i = 0; i < 80; ++i)
+        {
+            points.push_back(Residue{i*i + 3*i + 1});
+            coeffs.push_back(Residue{i*2654435761u});
+        }
+        auto const poly = mpp::Poly<Residue>{coeffs};
+        auto const values = poly(std::span<Residue const>{points});
+        std::vector<Residue> found(points.size());
+        mpp::polynomials::interpolate(std::span<Residue const>{points},std::span<Residue const>{values},std::span<Residue>{found});
+        EXPECT_TRUE(found == coeffs);
+    }
+}
+
+template <typename Tp>
+static auto naive_pow(Tp base, uint64_t exponent, Tp m)
+{
+    unsigned __int128 result = 1 % m, square = base % m;
+    for (; exponent; exponent >>= 1, square = square * square % m)
+        if (exponent & 1) result = result * square % m;
+    return Tp(result);
+}
+
+TEST(MPP_MOD, POW)
+{
+    using mpp::modular::pow;
+    {
+        // odd moduli through Montgomery form, even ones through Barrett's
+        for (uint64_t m : {0xffffffffffffffc5ULL, 1000000007ULL, (1ULL<<62) + 2, 2ULL, 1ULL})
+        {
+            for (uint64_t e : {0ULL, 1ULL, 2ULL, 5ULL, 255ULL, 0x123456789abcdefULL, ~0ULL})
+            {
+                auto const base = mpp::Mod<uint64_t>{m,0x5deece66dULL};
+                EXPECT_EQ(pow(base,e).value(), naive_pow<uint64_t>(0x5deece66dULL,e,m));
+            }
+        }
+        // even moduli above a third of the range, through Barrett's
+        EXPECT_EQ(pow(mpp::Mod<uint32_t>{2110021660u,1644385741u},294868933u).value(),
+            naive_pow<uint32_t>(1644385741u,294868933u,2110021660u));
+        uint64_t state = 1;
+        for (uint32_t m : {2110021660u, 2147483646u, 2147483648u})
+        {
+            for (int i = 0; i < 200; ++i)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                uint32_t const b = uint32_t(state >> 32) % m, e = uint32_t(state);
+                EXPECT_EQ(pow(mpp::Mod<uint32_t>{m,b},e).value(), naive_pow<uint32_t>(b,e,m));
+            }
+        }
+        // beyond Barrett's range, and with signed values
+        EXPECT_EQ(pow(mpp::Mod<uint64_t>{~0ULL - 1,3},1000u).value(), naive_pow<uint64_t>(3,1000,~0ULL - 1));
+        EXPECT_EQ(pow(mpp::Mod<int>{1000000007,2},1000000006u).value(), 1);
+        EXPECT_EQ(pow(mpp::Mod<int>{1000,3},0u).value(), 1);
+    }
+    {
+        // the residue types directly, and plain numbers
+        using Residue = mpp::StaticMod<uint32_t,998244353>;
+        EXPECT_TRUE(pow(Residue{3},998244352u) == Residue{1});
+        EXPECT_EQ(pow(mpp::Montgomery<uint32_t>{101,7},100u).value(), 1);
+        EXPECT_EQ(pow(3L,13u), 1594323L);
+    }
+    {
+        // fixed bases by comb, for every exponent width the table allows
+        auto const base = mpp::Montgomery<uint64_t>{0xffffffffffffffc5ULL,0x5deece66dULL};
+        auto const comb = mpp::modular::Comb{base};
+        EXPECT_EQ(comb.bits(), 66);
+        for (uint64_t e : {0ULL, 1ULL, 64ULL, 0xdeadbeefULL, 0x123456789abcdefULL, ~0ULL})
+        {
+            EXPECT_TRUE(comb.pow(e) == pow(base,e));
+        }
+
+        auto const small = mpp::modular::Comb{mpp::Mod<int>{1000003,5},20,4};
+        EXPECT_TRUE(small.pow(999999u) == pow(mpp::Mod<int>{1000003,5},999999u));
+        EXPECT_THROW(small.pow(1u << 20), std::out_of_range);
+    }
+    {
+        // products of powers share their squarings
+        constexpr uint64_t m = 0xffffffffffffffc5ULL;
+        auto const bases = std::vector<mpp::Mod<uint64_t>>{
+            mpp::Mod<uint64_t>{m,2}, mpp::Mod<uint64_t>{m,3}, mpp::Mod<uint64_t>{m,5},
+            mpp::Mod<uint64_t>{m,7}, mpp::Mod<uint64_t>{m,11}, mpp::Mod<uint64_t>{m,13} };
+        auto const exponents = std::vector<uint64_t>{ ~0ULL, 12345, 0, 1, 0xfedcba9876543210ULL, 77 };
+
+        for (size_t k : {1, 2, 6})
+        {
+            auto expected = mpp::Mod<uint64_t>{m,1};
+            for (size_t i = 0; i < k; ++i) expected *= pow(bases[i],exponents[i]);
+            auto const product = mpp::modular::multipow(
+                std::span<mpp::Mod<uint64_t> const>{bases.data(),k},
+                std::span<uint64_t const>{exponents.data(),k});
+            EXPECT_TRUE(product == expected);
+        }
+
+        using Residue = mpp::StaticMod<uint32_t,998244353>;
+        auto const residues = std::vector<Residue>{Residue{3},Residue{3}};
+        auto const halves = std::vector<uint32_t>{499122176,499122176};
+        EXPECT_TRUE(mpp::modular::multipow(std::span<Residue const>{residues},std::span<uint32_t const>{halves}) == Residue{1});
+        EXPECT_THROW(mpp::modular::multipow(std::span<Residue const>{residues},std::span<uint32_t const>{}), std::invalid_argument);
+    }
+}
+
+TEST(MPP_MOD, INVERT)
+{
+    using mpp::op_mul;
+    {
+        // unsigned residues invert through magnitudes, not wrapped coefficients
+        auto const mod = mpp::Mod<uint32_t>{1000003,2};
+        EXPECT_EQ((mpp::inverse<mpp::Mod<uint32_t>,op_mul>::get(mod).value()), 500002);
+    }
+    {
+        // a batch modulo a prime agrees with inverting one at a time
+        using Residue = mpp::StaticMod<uint32_t,998244353>;
+        auto values = std::vector<Residue>{};
+        for (uint32_t i = 1; i <= 1000; ++i) values.push_back(Residue{i * 2654435761u});
+        auto const original = values;
+
+        auto const failed = mpp::modular::invert(std::span<Residue>{values});
+        EXPECT_TRUE(failed.empty());
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            EXPECT_TRUE((values[i] == mpp::inverse<Residue,op_mul>::get(original[i])));
+        }
+    }
+    {
+        // elements sharing a factor with the modulus are reported and left alone
+        auto values = std::vector<mpp::Mod<int>>{};
+        for (int i = 0; i < 40; ++i) values.push_back(mpp::Mod<int>{1001,i*37+3});
+        auto const original = values;
+
+        auto const failed = mpp::modular::invert(std::span<mpp::Mod<int>>{values});
+        auto expected = std::vector<size_t>{};
+        for (size_t i = 0; i < original.size(); ++i)
+        {
+            if (mpp::gcd(original[i].value(),1001) != 1)
+            {
+                expected.push_back(i);
+                EXPECT_TRUE(values[i] == original[i]);
+            }
+            else
+            {
+                EXPECT_EQ((values[i] * original[i]).value(), 1);
+            }
+        }
+        EXPECT_FALSE(expected.empty());
+        EXPECT_EQ(failed, expected);
+    }
+    {
+        // unsigned residues try each inversion once, failing or not
+        auto values = std::vector<mpp::Mod<uint32_t>>{};
+        for (uint32_t i = 0; i < 40; ++i) values.push_back(mpp::Mod<uint32_t>{1000,i*37+3});
+        auto const original = values;
+
+        auto const failed = mpp::modular::invert(std::span<mpp::Mod<uint32_t>>{values});
+        for (size_t i : failed) EXPECT_NE(mpp::gcd<uint32_t>(original[i].value(),1000), 1u);
+        for (size_t i = 0; i < values.size(); ++i)
+        {
+            if (std::find(failed.begin(),failed.end(),i) == failed.end()) {
+                EXPECT_EQ((values[i] * original[i]).value(), 1u);
+            } else {
+                EXPECT_TRUE(values[i] == original[i]);
+            }
+        }
+        EXPECT_EQ(failed.size(), 24u);
+    }
+    {
+        // Montgomery residues, and empty batches
+        auto values = std::vector<mpp::Montgomery<uint64_t>>{};
+        for (uint64_t i = 0; i < 5; ++i) values.push_back(mpp::Montgomery<uint64_t>{0xffffffffffffffc5ULL,i});
+        auto const original = values;
+        EXPECT_EQ(mpp::modular::invert(std::span<mpp::Montgomery<uint64_t>>{values}), std::vector<size_t>{0});
+        for (size_t i = 1; i < values.size(); ++i) EXPECT_EQ((values[i] * original[i]).value(), 1);
+        EXPECT_TRUE(mpp::modular::invert(std::span<mpp::Montgomery<uint64_t>>{}).empty());
+    }
+}
@@ -0,0 +1,134 @@
+
+#include "gtest/gtest.h"
+
+#include <mathpp/dynmatrix.hh>
+using namespace mpp;
+
+#include <atomic>
+#include <numeric>
+#include <stdexcept>
+
+TEST(MPP_PARALLEL, POOL)
+{
+    ThreadPool pool{3};
+    EXPECT_EQ(pool.workers(),3);
+    {
+        // every index is visited exactly once
+        std::vector<int> visits(1000);
+        pool.parallel_for(0,visits.size(),7,[&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) ++visits[i];
+        });
+        EXPECT_TRUE(std::all_of(visits.begin(),visits.end(),[](int v){ return v == 1; }));
+    }
+    {
+        // loops may nest
+        std::atomic<size_t> total{0};
+        pool.parallel_for(0,8,1,[&](size_t lo, size_t hi) {
+            for (size_t i = lo; i < hi; ++i) {
+                pool.parallel_for(0,100,10,[&](size_t l, size_t h) { total += h - l; });
+            }
+        });
+        EXPECT_EQ(total,800);
+    }
+    {
+        // the first exception is rethrown on the calling thread
+        auto const fail = [](size_t lo, size_t) { if (lo == 40) throw std::runtime_error("fail"); };
+        EXPECT_THROW(pool.parallel_for(0,100,10,fail), std::runtime_error);
+    }
+    {
+        // a pool without workers runs inline
+        ThreadPool serial{0};
+        size_t calls = 0;
+        serial.parallel_for(0,100,10,[&](size_t, size_t) { ++calls; });
+        EXPECT_EQ(calls,1);
+    }
+}
+
+TEST(MPP_PARALLEL, MATRIX)
+{
+    ThreadPool pool{3};
+    auto const policy = execution::par.on(pool).with_grain(2);
+
+    Matrix<long,24,24> a, b;
+    for (size_t i = 0; i < a.size(); ++i)
+    {
+        a[i] = long(i*7 % 11) - 5;
+        b[i] = long(i*5 % 13) - 6;
+    }
+    {
+        // integral products are exact on any number of threads
+        EXPECT_TRUE(matrices::multiply(policy,a,b) == a * b);
+        EXPECT_TRUE(matrices::multiply(execution::par,a,b) == a * b);
+        EXPECT_TRUE(matrices::multiply(execution::seq,a,b) == a * b);
+    }
+    {
+        // integral determinants by fraction-free elimination
+        EXPECT_EQ(matrices::determinant(policy,a),matrices::determinant(a));
+        EXPECT_EQ(matrices::determinant(policy,b),matrices::determinant(b));
+    }
+
+    Matrix<double,24,24> c;
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+        c[i] = double(i*7 % 11) - 5 + ((i % 25 == 0) ? 20 : 0);
+    }
+    {
+        // floating results match the sequenced ones bit for bit
+        EXPECT_TRUE(matrices::multiply(policy,c,c) == c * c);
+        EXPECT_EQ(matrices::determinant(policy,c),matrices::determinant(c));
+        EXPECT_TRUE((matrices::invert(policy,c) == inverse<decltype(c),op_mul>::get(c)));
+
+        auto const lu = matrices::LU<double,24>{policy,c};
+        EXPECT_TRUE((lu.factors() == matrices::LU<double,24>{c}.factors()));
+        EXPECT_TRUE(lu.solve(policy,c) == lu.solve(c));
+    }
+    {
+        // an explicit grain splits elimination into a chunk per row
+        auto const rows = execution::par.on(pool).with_grain(1);
+
+        auto a1 = a, a2 = a;
+        EXPECT_EQ(matrices::bareiss(rows,a1.data(),24),matrices::bareiss(a2.data(),24));
+
+        std::array<size_t,24> p1, p2;
+        std::array<double,24> r1, r2;
+        bool o1, o2;
+        auto c1 = c, c2 = c;
+        EXPECT_EQ(matrices::lu_factor(rows,c1.data(),24,p1.data(),r1.data(),o1),
+                  matrices::lu_factor(c2.data(),24,p2.data(),r2.data(),o2));
+        EXPECT_TRUE(c1 == c2);
+        EXPECT_EQ(p1,p2);
+
+        auto c3 = c, c4 = c;
+        auto i1 = identity<decltype(c),op_mul>::get(), i2 = i1;
+        matrices::gauss_jordan(rows,c3.data(),24,i1.data());
+        matrices::gauss_jordan(c4.data(),24,i2.data());
+        EXPECT_TRUE(i1 == i2);
+    }
+}
+
+TEST(MPP_PARALLEL, DYNMATRIX)
+{
+    ThreadPool pool{2};
+    auto const policy = execution::par.on(pool);
+
+    DynMatrix<double> a{40,40}, b{40,30};
+    for (size_t i = 0; i < a.size(); ++i) a[i] = double(i*7 % 11) - 5 + ((i % 41 == 0) ? 20 : 0);
+    for (size_t i = 0; i < b.size(); ++i) b[i] = double(i*5 % 13) - 6;
+    {
+        EXPECT_TRUE(matrices::multiply(policy,a,b) == a * b);
+        EXPECT_EQ(matrices::determinant(policy,a),matrices::determinant(a));
+        EXPECT_TRUE((matrices::invert(policy,a) == inverse<DynMatrix<double>,op_mul>::get(a)));
+        EXPECT_THROW(matrices::multiply(policy,b,a), std::invalid_argument);
+    }
+    {
+        // several packed blocks of B, each shared by many panels of rows
+        DynMatrix<double> d{130,300}, e{300,20};
+        for (size_t i = 0; i < d.size(); ++i) d[i] = double(i*3 % 7) - 3;
+        for (size_t i = 0; i < e.size(); ++i) e[i] = double(i*5 % 9) - 4;
+        EXPECT_TRUE(matrices::multiply(policy,d,e) == d * e);
+    }
+    {
+        auto const lu = matrices::LU<double>{policy,a};
+        EXPECT_TRUE(lu.solve(policy,b) == lu.solve(b));
+    }
+}
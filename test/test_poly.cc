@@ -3,9 +3,18 @@
 
 #include <mathpp/poly.hh>
 #include <mathpp/gcd.hh>
+#include <mathpp/mod.hh>
+
+#include <thread>
 
 TEST(MPP_POLY, LIFETIME)
 {
+    {
+        // a plain value type, moved without copying
+        static_assert(std::is_final<mpp::Poly<int>>::value);
+        static_assert(!std::is_polymorphic<mpp::Poly<int>>::value);
+        static_assert(std::is_nothrow_move_constructible<mpp::Poly<int>>::value);
+    }
     {
         auto vec = std::vector<int>{0};
         auto poly = mpp::Poly<int>{};                       // default
@@ -100,6 +109,93 @@ TEST(MPP_POLY, LIFETIME)
     }
 }
 
+TEST(MPP_POLY, ORDER)
+{
+    {
+        // the cached degree follows every mutation
+        auto poly = mpp::Poly<int>{1,2,0,0};
+        EXPECT_EQ(poly.order(), 1);
+        poly[5] = 3;
+        EXPECT_EQ(poly.order(), 5);
+        poly.at(5) = 0;
+        EXPECT_EQ(poly.order(), 1);
+        poly.coeffs().back() = 7;
+        EXPECT_EQ(poly.order(), 5);
+        EXPECT_EQ(poly.back(), 7);
+        poly -= mpp::Poly<int>{0,0,0,0,0,7};
+        EXPECT_EQ(poly.order(), 1);
+        poly <<= 2;
+        EXPECT_EQ(poly.order(), 3);
+    }
+    {
+        // coefficients written through held references are seen by every query
+        auto poly = mpp::Poly<int>{0,0,0,0};
+        auto& coeffs = poly.coeffs();
+        for (size_t i = 0; i <= 3; ++i)
+        {
+            EXPECT_EQ(poly.order(), i == 0 ? 0 : i-1);
+            coeffs[i] = int(i) + 1;
+        }
+        EXPECT_EQ(poly.order(), 3);
+        EXPECT_EQ(poly.back(), 4);
+        EXPECT_TRUE((poly == mpp::Poly<int>{1,2,3,4}));
+
+        auto& lead = poly[3];
+        EXPECT_EQ(poly.order(), 3);
+        lead = 0;
+        EXPECT_EQ(poly.order(), 2);
+        auto copy = poly;
+        poly.at(2) = 0;
+        EXPECT_EQ(poly.order(), 1);
+        EXPECT_EQ(copy.order(), 2);
+    }
+    {
+        // trimming keeps the leading coefficient
+        auto poly = mpp::Poly<int>{1,2,3,0,0};
+        poly.trim();
+        EXPECT_EQ(poly.coeffs(), (std::vector<int>{1,2,3}));
+        EXPECT_EQ(poly.order(), 2);
+
+        auto zero = mpp::Poly<int>{0,0,0};
+        zero.trim();
+        EXPECT_EQ(zero.coeffs(), (std::vector<int>{0}));
+    }
+    {
+        // copies carry the degree, casts find it again
+        auto const poly1 = mpp::Poly<int>{4,0,2,0};
+        EXPECT_EQ(poly1.order(), 2);
+        auto const poly2 = poly1;
+        EXPECT_EQ(poly2.order(), 2);
+        auto poly3 = mpp::Poly<double>{};
+        EXPECT_EQ(poly3.order(), 0);
+        poly3 = poly1;
+        EXPECT_EQ(poly3.order(), 2);
+    }
+    {
+        // reading past the end of a const polynomial leaves it untouched
+        auto const poly = mpp::Poly<int>{1,2,3};
+        EXPECT_EQ(poly[10], 0);
+        EXPECT_EQ(poly.at(10), 0);
+        EXPECT_EQ(poly.size(), 3);
+    }
+    {
+        // const readers share a polynomial across threads
+        auto const poly = mpp::Poly<long>{std::vector<long>(4096,1)};
+        auto readers = std::vector<std::thread>{};
+        auto sums = std::vector<long>(4);
+        for (size_t t = 0; t < sums.size(); ++t)
+        {
+            readers.emplace_back([&poly,&sums,t]{
+                for (size_t i = 0; i < 2*poly.size(); ++i) sums[t] += poly[i];
+                sums[t] += long(poly.order());
+            });
+        }
+        for (auto& reader : readers) reader.join();
+        for (auto sum : sums) EXPECT_EQ(sum, 4096+4095);
+        EXPECT_EQ(poly.size(), 4096);
+    }
+}
+
 TEST(MPP_POLY, MATHPP)
 {
     using mpp::op_add;  using mpp::op_mul;
@@ -392,6 +488,319 @@ TEST(MPP_POLY, MATH_EXTRA)
     }
 }
 
+TEST(MPP_POLY, MULTIPLY)
+{
+    {
+        // products hold exactly one coefficient per degree
+        auto poly1 = mpp::Poly<int>{1,2,3};
+        poly1 *= mpp::Poly<int>{4,5,6,7};
+        EXPECT_EQ(poly1.size(), 6);
+    }
+    for (auto [na,nb] : {std::pair{40,40}, std::pair{57,31}, std::pair{300,300}, std::pair{1000,333}, std::pair{5,700}})
+    {
+        std::vector<long> a(na), b(nb);
+        for (int i = 0; i < na; ++i) a[i] = (i*7919 % 201) - 100;
+        for (int i = 0; i < nb; ++i) b[i] = (i*104729 % 173) - 86;
+
+        // Karatsuba and Toom-3 agree with the schoolbook product
+        std::vector<long> fast(na+nb-1), slow(na+nb-1);
+        mpp::polynomials::multiply(std::span<long>{fast},std::span<long const>{a},std::span<long const>{b});
+        mpp::polynomials::multiply_schoolbook(std::span<long>{slow},std::span<long const>{a},std::span<long const>{b});
+        EXPECT_EQ(fast, slow);
+
+        auto const product = mpp::Poly<long>{a} * mpp::Poly<long>{b};
+        EXPECT_EQ(product.coeffs(), slow);
+    }
+    {
+        std::vector<double> a(500), b(400);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = double(i % 17) - 8;
+        for (size_t i = 0; i < b.size(); ++i) b[i] = double(i % 13) - 6;
+
+        auto const product = mpp::Poly<double>{a} * mpp::Poly<double>{b};
+        std::vector<double> slow(a.size()+b.size()-1);
+        mpp::polynomials::multiply_schoolbook(std::span<double>{slow},std::span<double const>{a},std::span<double const>{b});
+        ASSERT_EQ(product.size(), slow.size());
+        for (size_t i = 0; i < slow.size(); ++i) EXPECT_DOUBLE_EQ(product[i], slow[i]);
+    }
+    {
+        // rings without Toom-3 multiply by Karatsuba alone
+        std::vector<unsigned> a(45), b(41);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = unsigned(i*7919 % 201);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = unsigned(i*104729 % 173);
+
+        auto const product = mpp::Poly<unsigned>{a} * mpp::Poly<unsigned>{b};
+        std::vector<unsigned> slow(a.size()+b.size()-1);
+        mpp::polynomials::multiply_schoolbook(std::span<unsigned>{slow},std::span<unsigned const>{a},std::span<unsigned const>{b});
+        EXPECT_EQ(product.coeffs(), slow);
+    }
+    {
+        // Toom-3 evaluates at -2 and overflows first, so falls back while
+        // every true coefficient still fits
+        std::vector<int> a(480);
+        for (size_t i = 0; i < a.size(); ++i) a[i] = (i % 3 == 0) ? 1000 : -1000;
+
+        std::vector<int> fast(2*a.size()-1);
+        std::vector<long> slow(2*a.size()-1);
+        mpp::polynomials::multiply(std::span<int>{fast},std::span<int const>{a},std::span<int const>{a});
+        auto const wide = std::vector<long>(a.begin(),a.end());
+        mpp::polynomials::multiply_schoolbook(std::span<long>{slow},std::span<long const>{wide},std::span<long const>{wide});
+        EXPECT_EQ(std::vector<long>(fast.begin(),fast.end()), slow);
+    }
+}
+
+TEST(MPP_POLY, DIVIDE)
+{
+    {
+        // a = r + q b, by Newton iteration for a long monic divisor
+        std::vector<long> b(1500), q(1200), r(1499);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = long(i % 7) - 3;
+        for (size_t i = 0; i < q.size(); ++i) q[i] = long(i % 11) - 5;
+        for (size_t i = 0; i < r.size(); ++i) r[i] = long(i % 5) - 2;
+        b.back() = 1;
+
+        auto const poly_b = mpp::Poly<long>{b}, poly_q = mpp::Poly<long>{q}, poly_r = mpp::Poly<long>{r};
+        auto const poly_a = poly_r + poly_q * poly_b;
+
+        auto [remainder,quotient] = mpp::division<mpp::Poly<long>,mpp::Poly<long>>::get(poly_a,poly_b);
+        EXPECT_TRUE(remainder == poly_r);
+        EXPECT_TRUE(quotient == poly_q);
+
+        auto poly = poly_a;
+        EXPECT_TRUE((poly %= poly_b) == poly_r);
+    }
+    {
+        // by Newton where the leading coefficient dominates, else term by term
+        for (double const lead : {2.0, 1024.0})
+        {
+            std::vector<double> b(1100), q(1100);
+            for (size_t i = 0; i < b.size(); ++i) b[i] = double(i % 3) * 0.5;
+            for (size_t i = 0; i < q.size(); ++i) q[i] = double(i % 4) - 1.5;
+            b.back() = lead;
+
+            auto const poly_b = mpp::Poly<double>{b}, poly_q = mpp::Poly<double>{q};
+            auto [remainder,quotient] = mpp::division<mpp::Poly<double>,mpp::Poly<double>>::get(poly_q * poly_b,poly_b);
+            ASSERT_EQ(quotient.size(), q.size());
+            for (size_t i = 0; i < q.size(); ++i) EXPECT_NEAR(quotient[i], q[i], 1e-6);
+            for (size_t i = 0; i < remainder.size(); ++i) EXPECT_NEAR(remainder[i], 0, 1e-6);
+        }
+    }
+    {
+        // term by term where the leading coefficient is not a unit
+        auto const poly1 = mpp::Poly<int>{1,0,0,4};
+        auto const poly2 = mpp::Poly<int>{1,2};
+        auto [r,s] = mpp::division<mpp::Poly<int>,mpp::Poly<int>>::get(poly1,poly2);
+        EXPECT_TRUE(r == (mpp::Poly<int>{1,1}));
+        EXPECT_TRUE(s == (mpp::Poly<int>{0,-1,2}));
+        EXPECT_THROW(poly1 % mpp::Poly<int>{0}, std::domain_error);
+    }
+}
+
+TEST(MPP_POLY, REDUCER)
+{
+    {
+        // long divisors are reduced in blocks by Barrett reduction
+        std::vector<long> b(300);
+        for (size_t i = 0; i < b.size(); ++i) b[i] = long(i % 7) - 3;
+        b.back() = -1;
+
+        auto const poly_b = mpp::Poly<long>{b};
+        auto reducer = mpp::polynomials::Reducer<long>{poly_b};
+        EXPECT_TRUE(reducer.barrett());
+
+        std::vector<mpp::Poly<long>> batch;
+        for (size_t n : {1, 299, 300, 301, 900, 2000})
+        {
+            std::vector<long> a(n);
+            for (size_t i = 0; i < a.size(); ++i) a[i] = long(i*i % 13) - 6;
+            batch.emplace_back(a);
+        }
+        auto const dividends = batch;
+        reducer.reduce(std::span<mpp::Poly<long>>{batch});
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            EXPECT_TRUE(batch[i] == dividends[i] % poly_b);
+        }
+    }
+    {
+        // short divisors term by term, multiplying by the inverse lead
+        auto reducer = mpp::polynomials::Reducer<double>{mpp::Poly<double>{1,0,4}};
+        EXPECT_FALSE(reducer.barrett());
+
+        auto poly = mpp::Poly<double>{3,1,8,4};
+        reducer.reduce(poly);
+        EXPECT_TRUE(poly == (mpp::Poly<double>{1,0}));
+    }
+    {
+        // non-unit integral leads as the operator would
+        auto reducer = mpp::polynomials::Reducer<int>{mpp::Poly<int>{1,2}};
+        auto poly = mpp::Poly<int>{1,0,0,4};
+        reducer.reduce(poly);
+        EXPECT_TRUE(poly == (mpp::Poly<int>{1,0,0,4} % mpp::Poly<int>{1,2}));
+        EXPECT_THROW(mpp::polynomials::Reducer<int>{mpp::Poly<int>{0}}, std::domain_error);
+    }
+}
+
+TEST(MPP_POLY, EVALUATE)
+{
+    {
+        // Horner's rule at a point
+        auto const poly = mpp::Poly<int>{1,-2,0,3};
+        EXPECT_EQ(poly(0), 1);
+        EXPECT_EQ(poly(2), 21);
+        EXPECT_EQ(poly(-1), 0);
+        EXPECT_DOUBLE_EQ((mpp::Poly<double>{0.5,0,2})(1.5), 5);
+    }
+    {
+        // many points at once, across vector lanes and the scalar tail
+        std::vector<double> coeffs(37), points(203);
+        for (size_t i = 0; i < coeffs.size(); ++i) coeffs[i] = double(i % 5) - 2;
+        for (size_t j = 0; j < points.size(); ++j) points[j] = double(j) / 200 - 0.5;
+
+        auto const poly = mpp::Poly<double>{coeffs};
+        auto const values = poly(std::span<double const>{points});
+        for (size_t j = 0; j < points.size(); ++j) EXPECT_NEAR(values[j], poly(points[j]), 1e-12);
+
+        auto const single = std::vector<float>(coeffs.begin(),coeffs.end());
+        auto const fpoints = std::vector<float>(points.begin(),points.end());
+        auto const fvalues = mpp::Poly<float>{single}(std::span<float const>{fpoints});
+        for (size_t j = 0; j < points.size(); ++j) EXPECT_NEAR(fvalues[j], values[j], 1e-3);
+    }
+    {
+        // integral points down a subproduct tree, wrapping as Horner does
+        std::vector<long> coeffs(700), points(900);
+        for (size_t i = 0; i < coeffs.size(); ++i) coeffs[i] = long(i*i % 17) - 8;
+        for (size_t j = 0; j < points.size(); ++j) points[j] = long(j % 23) - 11;
+
+        std::vector<long> tree(points.size()), horner(points.size());
+        mpp::polynomials::evaluate_tree(std::span<long const>{coeffs},std::span<long const>{points},std::span<long>{tree});
+        mpp::polynomials::evaluate_horner(std::span<long const>{coeffs},std::span<long const>{points},std::span<long>{horner});
+        EXPECT_EQ(tree, horner);
+        EXPECT_EQ((mpp::Poly<long>{coeffs}(std::span<long const>{points})), horner);
+
+        auto const ints = std::vector<int>(coeffs.begin(),coeffs.end());
+        auto const ipoints = std::vector<int>(points.begin(),points.end());
+        auto const ivalues = mpp::Poly<int>{ints}(std::span<int const>{ipoints});
+        for (size_t j = 0; j < points.size(); ++j) EXPECT_EQ(ivalues[j], (mpp::Poly<int>{ints})(ipoints[j]));
+    }
+    {
+        // modular coefficients
+        auto const coeffs = std::vector<mpp::Mod<int>>{mpp::Mod<int>{7,3},mpp::Mod<int>{7,5},mpp::Mod<int>{7,1}};
+        auto const value = mpp::polynomials::evaluate(std::span<mpp::Mod<int> const>{coeffs},mpp::Mod<int>{7,4});
+        EXPECT_EQ(value.value(), (3 + 5*4 + 16) % 7);
+
+        auto const points = std::vector<mpp::Mod<int>>{mpp::Mod<int>{7,2},mpp::Mod<int>{7,6}};
+        auto values = std::vector<mpp::Mod<int>>(points.size(),mpp::Mod<int>{7,0});
+        mpp::polynomials::evaluate(std::span<mpp::Mod<int> const>{coeffs},std::span<mpp::Mod<int> const>{points},std::span<mpp::Mod<int>>{values});
+        EXPECT_EQ(values[0].value(), (3 + 10 + 4) % 7);
+        EXPECT_EQ(values[1].value(), (3 + 30 + 36) % 7);
+    }
+}
+
+// integers modulo a prime, for exact interpolation over a field
+struct Residue
+{
+    constexpr static uint64_t modulus = 998244353;
+    uint64_t value = 0;
+
+    friend Residue operator+(Residue a, Residue b) { return {(a.value + b.value) % modulus}; }
+    friend Residue operator-(Residue a, Residue b) { return {(a.value + modulus - b.value) % modulus}; }
+    friend Residue operator*(Residue a, Residue b) { return {a.value * b.value % modulus}; }
+    friend Residue operator/(Residue a, Residue b)
+    {
+        uint64_t inv = 1, base = b.value;
+        for (uint64_t e = modulus-2; e; e >>= 1, base = base * base % modulus) if (e & 1) inv = inv * base % modulus;
+        return a * Residue{inv};
+    }
+    Residue& operator+=(Residue b) { return *this = *this + b; }
+    Residue& operator-=(Residue b) { return *this = *this - b; }
+    Residue& operator*=(Residue b) { return *this = *this * b; }
+    bool operator==(Residue const&) const = default;
+};
+
+template <>
+struct mpp::identity<Residue,mpp::op_add>
+{
+    constexpr static mpp::tristate has() { return mpp::logic::all; }
+    constexpr static Residue get() { return {0}; }
+};
+
+template <>
+struct mpp::identity<Residue,mpp::op_mul>
+{
+    constexpr static mpp::tristate has() { return mpp::logic::all; }
+    constexpr static Residue get() { return {1}; }
+};
+
+template <>
+struct mpp::inverse<Residue,mpp::op_mul>
+{
+    constexpr static mpp::tristate has() { return mpp::logic::all; }
+    constexpr static bool can(Residue const& e) { return e.value != 0; }
+    static Residue get(Residue const& e) { return Residue{1} / e; }
+};
+
+TEST(MPP_POLY, INTERPOLATE)
+{
+    {
+        // few floating points by divided differences
+        auto const poly = mpp::Poly<double>{1,-2,0,3,0.5};
+        std::vector<double> points{-2,-1,0,1,2}, values(points.size()), coeffs(points.size());
+        for (size_t j = 0; j < points.size(); ++j) values[j] = poly(points[j]);
+
+        mpp::polynomials::interpolate(std::span<double const>{points},std::span<double const>{values},std::span<double>{coeffs});
+        for (size_t i = 0; i < coeffs.size(); ++i) EXPECT_NEAR(coeffs[i], poly[i], 1e-12);
+
+        auto const interpolator = mpp::polynomials::Interpolator<double>{std::span<double const>{points}};
+        auto const result = interpolator.interpolate(std::span<double const>{values});
+        for (size_t i = 0; i < coeffs.size(); ++i) EXPECT_NEAR(result[i], poly[i], 1e-12);
+    }
+    {
+        // many points of a prime field up the tree, and by divided differences
+        std::vector<Residue> points(300), coeffs(300);
+        for (size_t j = 0; j < points.size(); ++j) points[j] = Residue{j * 7919 + 13};
+        for (size_t i = 0; i < coeffs.size(); ++i) coeffs[i] = Residue{i * i * 31 + 5};
+
+        std::vector<Residue> values(points.size());
+        mpp::polynomials::evaluate(std::span<Residue const>{coeffs},std::span<Residue const>{points},std::span<Residue>{values});
+
+        std::vector<Residue> tree(points.size()), newton(points.size());
+        mpp::polynomials::interpolate(std::span<Residue const>{points},std::span<Residue const>{values},std::span<Residue>{tree});
+        mpp::polynomials::interpolate_newton(std::span<Residue const>{points},std::span<Residue const>{values},std::span<Residue>{newton});
+        EXPECT_TRUE(tree == coeffs);
+        EXPECT_TRUE(newton == coeffs);
+    }
+    {
+        // modular coefficients by divided differences
+        using mod = mpp::Mod<int>;
+        std::vector<mod> points{mod{7,1},mod{7,2},mod{7,3}}, values{mod{7,6},mod{7,3},mod{7,1}};
+        std::vector<mod> coeffs(points.size(),mod{7,0});
+        mpp::polynomials::interpolate(std::span<mod const>{points},std::span<mod const>{values},std::span<mod>{coeffs});
+        for (size_t j = 0; j < points.size(); ++j)
+        {
+            EXPECT_EQ(mpp::polynomials::evaluate(std::span<mod const>{coeffs},points[j]).value(), values[j].value());
+        }
+    }
+    {
+        // a batch through shared points builds the tree once
+        std::vector<Residue> points(100);
+        for (size_t j = 0; j < points.size(); ++j) points[j] = Residue{j * j + 1};
+        auto const interpolator = mpp::polynomials::Interpolator<Residue>{std::span<Residue const>{points}};
+
+        std::vector<std::vector<Residue>> batch(3,std::vector<Residue>(points.size()));
+        for (size_t k = 0; k < batch.size(); ++k)
+            for (size_t j = 0; j < points.size(); ++j) batch[k][j] = Residue{(k+1) * j};
+
+        auto const polys = interpolator.interpolate(std::span<std::vector<Residue> const>{batch});
+        ASSERT_EQ(polys.size(), batch.size());
+        for (size_t k = 0; k < batch.size(); ++k)
+        {
+            std::vector<Residue> values(points.size());
+            interpolator.tree().evaluate(std::span<Residue const>{polys[k].coeffs()},std::span<Residue>{values});
+            EXPECT_TRUE(values == batch[k]);
+        }
+    }
+}
+
 TEST(MPP_POLY, GCD)
 {
     {
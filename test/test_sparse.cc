@@ -0,0 +1,91 @@
+
+#include "gtest/gtest.h"
+
+#include <mathpp/sparse.hh>
+using namespace mpp;
+
+TEST(MPP_SPARSE, LIFETIME)
+{
+    {
+        // terms are sorted, like terms summed, and zero terms dropped
+        auto const poly = SparsePoly<int>{{5,2},{0,1},{5,3},{2,0}};
+        EXPECT_EQ(poly.size(), 2);
+        EXPECT_EQ(poly.order(), 5);
+        EXPECT_EQ(poly.back(), 5);
+        EXPECT_EQ(poly[0], 1);
+        EXPECT_EQ(poly[3], 0);
+        EXPECT_EQ(SparsePoly<int>{}.size(), 0);
+    }
+    {
+        // to and from the dense representation
+        auto coeffs = std::vector<int>(20);
+        coeffs.front() = 1;
+        coeffs.back() = -2;
+        auto const dense = Poly<int>{coeffs};
+        auto const sparse = SparsePoly<int>{dense};
+        EXPECT_TRUE(sparse == (SparsePoly<int>{{0,1},{19,-2}}));
+        EXPECT_TRUE(static_cast<Poly<int>>(sparse) == dense);
+        EXPECT_TRUE(polynomials::is_sparse(dense));
+        EXPECT_FALSE(polynomials::is_sparse(Poly<int>{1,2,3}));
+    }
+    {
+        // high degrees cost nothing to shift or evaluate
+        auto const poly = SparsePoly<long>{{0,1}} << 1000000;
+        EXPECT_EQ(poly.size(), 1);
+        EXPECT_EQ(poly.order(), 1000000);
+        EXPECT_EQ((poly + SparsePoly<long>{{0,1}})(1), 2);
+        EXPECT_EQ((SparsePoly<long>{{3,2},{1,-1},{0,4}})(3), 55);
+        EXPECT_TRUE((poly >> 999999) == (SparsePoly<long>{{1,1}}));
+    }
+}
+
+TEST(MPP_SPARSE, ARITHMETIC)
+{
+    auto const a = SparsePoly<int>{{0,1},{3,2},{10,-1}};
+    auto const b = SparsePoly<int>{{1,4},{3,-2},{7,1}};
+    {
+        // sums and products agree with the dense ones
+        auto const da = static_cast<Poly<int>>(a), db = static_cast<Poly<int>>(b);
+        EXPECT_TRUE(static_cast<Poly<int>>(a + b) == da + db);
+        EXPECT_TRUE(static_cast<Poly<int>>(a - b) == da - db);
+        EXPECT_TRUE(static_cast<Poly<int>>(a * b) == da * db);
+        EXPECT_TRUE((a - a).size() == 0);
+    }
+    {
+        // cancelling products leave no terms behind
+        auto const c = SparsePoly<int>{{0,1},{1,1}}, d = SparsePoly<int>{{0,1},{1,-1}};
+        EXPECT_TRUE(c * d == (SparsePoly<int>{{0,1},{2,-1}}));
+        EXPECT_TRUE(a * 3 == 3 * a);
+    }
+}
+
+TEST(MPP_SPARSE, DIVIDE)
+{
+    {
+        // x^1000 modulo the trinomial x^7 + x + 1, agreeing with the dense remainder
+        auto const modulus = SparsePoly<long>{{0,1},{1,1},{7,1}};
+        auto const poly = SparsePoly<long>{{0,3},{1000,1}};
+
+        auto const [remainder,quotient] = division<SparsePoly<long>,SparsePoly<long>>::get(poly,modulus);
+        auto const dense = static_cast<Poly<long>>(poly) % static_cast<Poly<long>>(modulus);
+        EXPECT_TRUE(static_cast<Poly<long>>(remainder) == dense);
+        EXPECT_TRUE(quotient * modulus + remainder == poly);
+        EXPECT_TRUE(static_cast<Poly<long>>(poly) % modulus == dense);
+        EXPECT_LE(remainder.order(), 6);
+    }
+    {
+        // non-unit leading coefficients leave what they cannot cancel
+        auto const poly = SparsePoly<int>{{0,1},{3,4}}, divisor = SparsePoly<int>{{0,1},{1,2}};
+        auto const dense = Poly<int>{1,0,0,4} % Poly<int>{1,2};
+        EXPECT_TRUE(static_cast<Poly<int>>(poly % divisor) == dense);
+        EXPECT_THROW(poly % SparsePoly<int>{}, std::domain_error);
+    }
+    {
+        // floating divisors by the pentanomial x^8 + x^4 + x^3 + x + 1
+        auto const modulus = SparsePoly<double>{{0,1},{1,1},{3,1},{4,1},{8,1}};
+        auto poly = SparsePoly<double>{{2,0.5},{40,1.5}};
+        auto const dense = static_cast<Poly<double>>(poly) % static_cast<Poly<double>>(modulus);
+        poly %= modulus;
+        for (size_t i = 0; i < 8; ++i) EXPECT_NEAR(poly[i], dense[i], 1e-9);
+    }
+}
@@ -7,22 +7,22 @@ using namespace mpp;
 TEST(MPP_VECTOR, LIFETIME)
 {
     {
-        auto elems = std::vector<int>{0,0,0};
+        auto elems = std::array<int,3>{0,0,0};
         auto vec = Vector<int,3>{};                         // default
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,1,1};
+        auto elems = std::array<int,3>{1,1,1};
         auto vec = Vector<int,3>(1);                        // fill
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3};
+        auto elems = std::array<int,3>{1,2,3};
         auto vec = Vector<int,3>{1,2,3};                    // forward elements
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3};
+        auto elems = std::array<int,3>{1,2,3};
         auto vec = Vector<int,3>{};
         vec = {1,2,3};                                      // assign initializer_list
         EXPECT_EQ(vec.elements(), elems);
@@ -77,6 +77,29 @@ TEST(MPP_VECTOR, LIFETIME)
     }
 }
 
+TEST(MPP_VECTOR, STORAGE)
+{
+    {
+        // vectors are packed, so arrays of vectors are arrays of elements
+        static_assert(sizeof(Vector<float,3>) == 3*sizeof(float));
+        static_assert(std::is_trivially_copyable<Vector<float,3>>::value);
+        static_assert(std::is_standard_layout<Vector<float,3>>::value);
+
+        auto vecs = std::vector<Vector<float,3>>{{1,2,3},{4,5,6}};
+        auto const* data = vecs.front().data();
+        for (size_t i = 0; i < 6; ++i)
+        {
+            EXPECT_EQ(data[i], static_cast<float>(i+1));
+        }
+    }
+    {
+        // vectors are usable in constant expressions
+        constexpr auto vec1 = Vector<int,3>{1,2,3};
+        constexpr Vector<int,3> vec2 = (vec1 + vec1) * 2 - vec1;
+        static_assert(vec2[0] == 3 && vec2[1] == 6 && vec2[2] == 9);
+    }
+}
+
 TEST(MPP_VECTOR, MATHPP)
 {
     {
@@ -163,7 +186,7 @@ TEST(MPP_VECTOR, OPERATORS)
         EXPECT_TRUE(vec1 != vec2);
     }
     {
-        auto elems1 = std::vector<int>{1,2,3}, elems2 = std::vector<int>{4,5,6};
+        auto elems1 = std::array<int,3>{1,2,3}, elems2 = std::array<int,3>{4,5,6};
         auto vec1 = Vector<int,3>{1,2,3}, vec2 = Vector<int,3>{4,5,6};
 
         std::swap(vec1,vec2);
@@ -182,31 +205,31 @@ TEST(MPP_VECTOR, MATH_SELF)
     auto const vec2 = Vector<int,3>{2,4,6};
     auto const scalar = 2.0f;
     {
-        auto elems = std::vector<int>{3,6,9};
+        auto elems = std::array<int,3>{3,6,9};
         auto vec = Vector<int,3>{vec2};
         vec += vec1;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3};
+        auto elems = std::array<int,3>{1,2,3};
         auto vec = Vector<int,3>{vec2};
         vec -= vec1;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{2,4,6};
+        auto elems = std::array<int,3>{2,4,6};
         auto vec = Vector<int,3>{vec1};
         vec *= scalar;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3};
+        auto elems = std::array<int,3>{1,2,3};
         auto vec = Vector<int,3>{vec2};
         vec /= scalar;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,0,1};
+        auto elems = std::array<int,3>{1,0,1};
         auto vec = Vector<int,3>{vec1};
         vec %= scalar;
         EXPECT_EQ(vec.elements(), elems);
@@ -219,38 +242,65 @@ TEST(MPP_VECTOR, MATH_EXTRA)
     auto const vec2 = Vector<int,3>{2,4,6};
     auto const scalar = 2.0f;
     {
-        auto elems = std::vector<int>{1,2,3};
+        auto elems = std::array<int,3>{1,2,3};
         auto vec = +vec1;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{-1,-2,-3};
+        auto elems = std::array<int,3>{-1,-2,-3};
         auto vec = -vec1;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{3,6,9};
+        auto elems = std::array<int,3>{3,6,9};
         auto vec = vec2 + vec1;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3};
+        auto elems = std::array<int,3>{1,2,3};
         auto vec = vec2 - vec1;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{2,4,6};
+        auto elems = std::array<int,3>{2,4,6};
         auto vec = vec1 * scalar;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,2,3};
+        auto elems = std::array<int,3>{1,2,3};
         auto vec = vec2 / scalar;
         EXPECT_EQ(vec.elements(), elems);
     }
     {
-        auto elems = std::vector<int>{1,0,1};
+        auto elems = std::array<int,3>{1,0,1};
         auto vec = vec1 % scalar;
         EXPECT_EQ(vec.elements(), elems);
     }
 }
+
+TEST(MPP_VECTOR, MATH_SIMD)
+{
+    // long vectors run through the vectorised kernels, including the tail
+    auto vec1 = Vector<double,37>{};
+    auto vec2 = Vector<double,37>{};
+    auto vec3 = Vector<int,37>{};
+    auto vec4 = Vector<int,37>{};
+    for (size_t i = 0; i < 37; ++i)
+    {
+        vec1[i] = static_cast<double>(i);
+        vec2[i] = static_cast<double>(2*i);
+        vec3[i] = static_cast<int>(i);
+        vec4[i] = static_cast<int>(3*i);
+    }
+    vec1 += vec2;
+    vec1 *= 4.0;
+    vec1 -= vec2;
+    vec1 /= 2.0;
+    vec3 -= vec4;
+    vec3 *= 5;
+    for (size_t i = 0; i < 37; ++i)
+    {
+        EXPECT_EQ(vec1[i], static_cast<double>(5*i));
+        EXPECT_EQ(vec3[i], -10*static_cast<int>(i));
+    }
+}
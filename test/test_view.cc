@@ -0,0 +1,118 @@
+
+#include "gtest/gtest.h"
+
+#include <mathpp/linalg.hh>
+using namespace mpp;
+
+template <typename Tp>
+concept add_assignable = requires (Tp a, Tp b) { a += b; };
+
+template <typename Tp>
+concept transposable = requires (Tp&& m) { matrices::transpose(std::forward<Tp>(m)); };
+
+TEST(MPP_VIEW, ACCESS)
+{
+    auto mat = Matrix<int,3,4>{1,2,3,4,5,6,7,8,9,10,11,12};
+    {
+        auto view = matrices::transpose(mat);
+        static_assert(std::is_same<decltype(view),MatrixView<int,4,3>>::value);
+        EXPECT_EQ((view[{3,1}]),8);
+        EXPECT_TRUE(view.eval() == (Matrix<int,4,3>{1,5,9,2,6,10,3,7,11,4,8,12}));
+        EXPECT_THROW((view.at({4,0})), std::out_of_range);
+    }
+    {
+        EXPECT_TRUE(matrices::row(mat,1) == (CoVector<int,4>{5,6,7,8}));
+        EXPECT_TRUE(matrices::col(mat,2) == (Vector<int,3>{3,7,11}));
+        EXPECT_TRUE(matrices::diagonal(mat) == (Vector<int,3>{1,6,11}));
+        EXPECT_TRUE((matrices::block<2,2>(mat,1,2) == Matrix<int,2,2>{7,8,11,12}));
+        EXPECT_THROW((matrices::block<2,2>(mat,2,0)), std::out_of_range);
+    }
+    {
+        // Views of views compose their strides
+        auto view = matrices::block<2,3>(mat,1,1).transpose();
+        EXPECT_TRUE((view == Matrix<int,3,2>{6,10,7,11,8,12}));
+        EXPECT_TRUE(view.row(2) == (CoVector<int,2>{8,12}));
+    }
+    {
+        // Views of const matrices are read-only
+        auto const& cmat = mat;
+        auto view = matrices::transpose(cmat);
+        static_assert(std::is_same<decltype(view),MatrixView<int const,4,3>>::value);
+        static_assert(!add_assignable<decltype(view)>);
+
+        // Views are not taken of temporaries
+        static_assert(transposable<Matrix<int,2,2>&>);
+        static_assert(!transposable<Matrix<int,2,2>>);
+    }
+}
+
+TEST(MPP_VIEW, ASSIGN)
+{
+    auto mat = Matrix<int,3,3>{};
+    {
+        matrices::block<2,2>(mat,1,1).assign(Matrix<int,2,2>{1,2,3,4});
+        matrices::row(mat,0) += CoVector<int,3>{1,1,1};
+        matrices::diagonal(mat) *= 10;
+        EXPECT_TRUE((mat == Matrix<int,3,3>{10,1,1,0,10,2,0,3,40}));
+    }
+    {
+        // Views take part in element-wise expressions
+        Matrix<int,3,3> result = matrices::transpose(mat) - mat;
+        EXPECT_TRUE((result == Matrix<int,3,3>{0,-1,-1,1,0,1,1,-1,0}));
+    }
+    {
+        // Containers assigned through views of themselves see no partial writes
+        auto mat1 = Matrix<int,2,2>{1,2,3,4};
+        mat1 = matrices::transpose(mat1);
+        EXPECT_TRUE((mat1 == Matrix<int,2,2>{1,3,2,4}));
+
+        auto mat2 = Matrix<int,2,2>{1,2,3,4};
+        mat2 = matrices::transpose(mat2) + mat2;
+        EXPECT_TRUE((mat2 == Matrix<int,2,2>{2,5,5,8}));
+
+        auto mat3 = Matrix<int,2,2>{1,2,3,4};
+        mat3 += matrices::transpose(mat3);
+        EXPECT_TRUE((mat3 == Matrix<int,2,2>{2,5,5,8}));
+
+        auto vec = Vector<int,3>{1,2,3};
+        auto const first = VectorView<int,3,true>{vec.data(),0};
+        vec = first + vec;
+        EXPECT_TRUE((vec == Vector<int,3>{2,3,4}));
+        vec -= VectorView<int,3,true>{vec.data(),0};
+        EXPECT_TRUE((vec == Vector<int,3>{0,1,2}));
+    }
+}
+
+TEST(MPP_VIEW, PRODUCT)
+{
+    {
+        auto const mat = Matrix<float,2,3>{1,2,3,4,5,6};
+        auto const vec = Vector<float,3>{1,1,1};
+        EXPECT_TRUE((mat * matrices::row(mat,0).transpose() == Vector<float,2>{14,32}));
+        EXPECT_TRUE((matrices::col(mat,1).transpose() * mat == CoVector<float,3>{22,29,36}));
+        EXPECT_TRUE((matrices::transpose(mat) * matrices::col(mat,0) == Vector<float,3>{17,22,27}));
+        EXPECT_EQ(matrices::row(mat,1) * vec, 15.0f);
+    }
+    {
+        // Transposed products read their operands in place
+        auto mat = Matrix<double,40,30>{};
+        for (size_t i = 0; i < mat.size(); ++i) mat[i] = double(i % 11) - 5;
+
+        auto result = matrices::transpose(mat) * mat;
+        auto expected = matrices::transpose(mat).eval() * mat;
+        EXPECT_TRUE(result == expected);
+
+        auto block = matrices::block<10,10>(mat,5,5) * matrices::block<10,10>(mat,20,15);
+        auto expected1 = matrices::block<10,10>(mat,5,5).eval() * matrices::block<10,10>(mat,20,15).eval();
+        EXPECT_TRUE(block == expected1);
+    }
+    {
+        // Promoted products, whose result type is not the element type
+        auto mat = Matrix<short,16,16>{};
+        for (size_t i = 0; i < mat.size(); ++i) mat[i] = short(i % 9) - 4;
+
+        auto result = matrices::transpose(mat) * mat;
+        auto expected = matrices::transpose(mat).eval() * mat;
+        EXPECT_TRUE(result == expected);
+    }
+}